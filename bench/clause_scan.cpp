@@ -0,0 +1,179 @@
+/*
+ * Program to measure the speed of the scans of long clauses done by the
+ * solver, with the scalar loop and with the scan it dispatches to, which is
+ * vectorized where the processor supports it. two scans are timed: looking
+ * for a literal that is not false to watch instead, in clauses whose literals
+ * are almost all false, and looking for a true literal in every clause, as the
+ * model is checked when the solver finishes
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../literal_scan.h"
+
+using namespace std;
+
+/*
+ * a formula of long clauses over packed literals, with an assignment of its
+ * variables
+ */
+struct LongClauses {
+  vector<int8_t> values;    // value of every literal, followed by padding
+  vector<int> literals;     // the literals of all clauses
+  vector<int> clause_start; // start of every clause, and the end of the last
+};
+
+/*
+ * function to make clauses of random variables under a random assignment of
+ * all but the first hundredth of the variables. every literal of a clause is
+ * false, except with a given probability, when it is true or unassigned
+ * Arguments : variable_count - the number of variables, clause_count - the
+ * number of clauses, clause_size - the literals in every clause, probability
+ * - the probability of a literal not being false, unassigned - true for
+ * these literals to be unassigned, false for them to be true, generator - the
+ * random numbers, formula - to store the clauses and the assignment
+ */
+void make_clauses(int variable_count, int clause_count, int clause_size,
+                  double probability, bool unassigned, mt19937 &generator,
+                  LongClauses &formula) {
+  int unassigned_count = variable_count / 100;
+  formula.values.assign(2 * variable_count + literal_value_padding, -1);
+  for (int i = unassigned_count; i < variable_count; i++) {
+    bool positive = generator() & 1;
+    formula.values[2 * i] = positive;
+    formula.values[2 * i + 1] = !positive;
+  }
+  uniform_int_distribution<int> unassigned_variable(0, unassigned_count - 1);
+  uniform_int_distribution<int> assigned_variable(unassigned_count,
+                                                  variable_count - 1);
+  bernoulli_distribution not_false(probability);
+  for (int i = 0; i < clause_count; i++) {
+    formula.clause_start.push_back(formula.literals.size());
+    for (int j = 0; j < clause_size; j++) {
+      bool wanted = not_false(generator);
+      if (wanted && unassigned) {
+        formula.literals.push_back(2 * unassigned_variable(generator) +
+                                   (generator() & 1));
+        continue;
+      }
+      int literal = 2 * assigned_variable(generator);
+      // pick the polarity that gives the wanted value
+      if ((formula.values[literal] == 1) != wanted) {
+        literal ^= 1;
+      }
+      formula.literals.push_back(literal);
+    }
+  }
+  formula.clause_start.push_back(formula.literals.size());
+}
+
+/*
+ * function to scan every clause of a formula a number of times
+ * Arguments : formula - the formula, rounds - the number of times, find_true
+ * - true to look for true literals, false for literals that are not false,
+ * vectorized - true to use the dispatched scan, false for the scalar loop,
+ * seconds - to store the time taken
+ * Return value : the sum of the positions found, to compare the two scans
+ */
+long long scan_clauses(const LongClauses &formula, int rounds, bool find_true,
+                       bool vectorized, double &seconds) {
+  long long position_sum = 0;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (int round = 0; round < rounds; round++) {
+    for (int i = 0; i + 1 < formula.clause_start.size(); i++) {
+      const int *clause = &formula.literals[formula.clause_start[i]];
+      int size = formula.clause_start[i + 1] - formula.clause_start[i];
+      position_sum +=
+          vectorized
+              ? scan_literals(formula.values.data(), clause, size, find_true)
+              : scan_literals_scalar(formula.values.data(), clause, size,
+                                     find_true);
+    }
+  }
+  seconds =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  return position_sum;
+}
+
+/*
+ * function to time a scan with both paths and print a line of the results
+ * Arguments : name - the name of the scan, formula - the formula, rounds -
+ * the number of rounds, find_true - what the scan looks for
+ * Return value : true, if both paths found the same literals, false, if not
+ */
+bool compare_scans(const char *name, const LongClauses &formula, int rounds,
+                   bool find_true) {
+  const int repetitions = 5; // runs of every path, of which the fastest is
+                             // kept, since the timings are noisy
+  double scalar_seconds = 1e100, vectorized_seconds = 1e100, seconds;
+  long long scalar_sum = 0, vectorized_sum = 0;
+  for (int i = 0; i < repetitions; i++) {
+    scalar_sum = scan_clauses(formula, rounds, find_true, false, seconds);
+    scalar_seconds = min(scalar_seconds, seconds);
+    vectorized_sum = scan_clauses(formula, rounds, find_true, true, seconds);
+    vectorized_seconds = min(vectorized_seconds, seconds);
+  }
+  // every position found is one more literal visited
+  double literals = (double)scalar_sum + (double)rounds *
+                                             (formula.clause_start.size() - 1);
+  printf("%-12s %10.3f %10.3f %14.1f %8.2fx\n", name, scalar_seconds,
+         vectorized_seconds, literals / vectorized_seconds / 1e6,
+         scalar_seconds / max(vectorized_seconds, 1e-9));
+  return scalar_sum == vectorized_sum;
+}
+
+/*
+ * the main() function
+ */
+int main(int argc, char *argv[]) {
+  const int variable_count = 100000;
+  int clause_size = 2000;
+  int clause_count = 1000;
+  int rounds = 50;
+  if (argc >= 2) {
+    clause_size = atoi(argv[1]);
+  }
+  if (argc >= 3) {
+    clause_count = atoi(argv[2]);
+  }
+  if (argc >= 4) {
+    rounds = atoi(argv[3]);
+  }
+  if (argc > 4 || clause_size <= 0 || clause_count <= 0 || rounds <= 0) {
+    cerr << "Usage: " << argv[0] << " [clause_size [clauses [rounds]]]"
+         << endl;
+    return 1;
+  }
+  mt19937 generator(1);
+  // the watch search is made in clauses with few unassigned literals among
+  // false ones, and the model check in clauses with few true literals
+  LongClauses watch_formula, model_formula;
+  make_clauses(variable_count, clause_count, clause_size, 0.002, true,
+               generator, watch_formula);
+  make_clauses(variable_count, clause_count, clause_size, 0.002, false,
+               generator, model_formula);
+#ifdef LITERAL_SCAN_AVX2
+  const char *path = avx2_supported() ? "AVX2" : "scalar";
+#else
+  const char *path = "scalar";
+#endif
+  printf("%d clauses of %d literals, %d rounds, best of 5 runs, dispatched "
+         "to %s\n",
+         clause_count, clause_size, rounds, path);
+  printf("%-12s %10s %10s %14s %9s\n", "scan", "scalar s", "dispatched s",
+         "Mliterals/s", "speedup");
+  bool same = compare_scans("watch", watch_formula, rounds, false) &&
+              compare_scans("model", model_formula, rounds, true);
+  if (!same) {
+    cerr << "The scans found different literals" << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,38 @@
+/*
+ * Program to write a formula of one of the benchmark families in DIMACS format
+ * on standard output
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "generator.h"
+
+using namespace std;
+
+/*
+ * the main() function
+ */
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    cerr << "Usage: " << argv[0] << " family arguments..." << endl
+         << "  random variables clauses clause_size seed" << endl
+         << "  pigeonhole holes" << endl
+         << "  parity width height satisfiable" << endl
+         << "  counter bits steps target" << endl;
+    return 1;
+  }
+  vector<int> arguments;
+  for (int i = 2; i < argc; i++) {
+    arguments.push_back(atoi(argv[i]));
+  }
+  Formula formula;
+  if (!generate_family(argv[1], arguments, formula)) {
+    cerr << "Unknown family or wrong arguments: " << argv[1] << endl;
+    return 1;
+  }
+  write_dimacs(formula, stdout);
+  return 0;
+}
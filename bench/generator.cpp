@@ -0,0 +1,286 @@
+/*
+ * Generators of CNF formulas from the families used to benchmark and check the
+ * SAT solver
+ */
+
+#include "generator.h"
+
+#include <cstdlib>
+#include <random>
+
+using namespace std;
+
+/*
+ * function to generate a random formula whose clauses each have a fixed number
+ * of distinct variables with random signs. with three literals per clause, the
+ * formulas are hardest at about 4.26 clauses per variable
+ * Arguments : variable_count - the number of variables, clause_count - the
+ * number of clauses, clause_size - the number of literals in every clause,
+ * seed - the seed of the random numbers, formula - to store the formula
+ */
+void generate_random(int variable_count, int clause_count, int clause_size,
+                     int seed, Formula &formula) {
+  mt19937 generator(seed);
+  uniform_int_distribution<int> choose_variable(1, variable_count);
+  formula.variable_count = variable_count;
+  formula.clauses.clear();
+  for (int i = 0; i < clause_count; i++) {
+    vector<int> clause;
+    while (clause.size() < clause_size && clause.size() < variable_count) {
+      int variable = choose_variable(generator);
+      bool repeated = false;
+      for (int j = 0; j < clause.size(); j++) {
+        repeated = repeated || abs(clause[j]) == variable;
+      }
+      if (!repeated) {
+        clause.push_back((generator() % 2 == 0) ? variable : -variable);
+      }
+    }
+    formula.clauses.push_back(clause);
+  }
+}
+
+/*
+ * function to generate the pigeonhole formula, which states that one pigeon
+ * more than there are holes can be put into the holes with at most one pigeon
+ * in every hole. it is unsatisfiable, and hard for resolution
+ * Arguments : hole_count - the number of holes, formula - to store the formula
+ */
+void generate_pigeonhole(int hole_count, Formula &formula) {
+  int pigeon_count = hole_count + 1;
+  // variable of pigeon p being in hole h, both zero indexed
+  auto in_hole = [hole_count](int p, int h) { return p * hole_count + h + 1; };
+  formula.variable_count = pigeon_count * hole_count;
+  formula.clauses.clear();
+  for (int p = 0; p < pigeon_count; p++) {
+    vector<int> clause;
+    for (int h = 0; h < hole_count; h++) {
+      clause.push_back(in_hole(p, h));
+    }
+    formula.clauses.push_back(clause);
+  }
+  for (int h = 0; h < hole_count; h++) {
+    for (int p = 0; p < pigeon_count; p++) {
+      for (int q = p + 1; q < pigeon_count; q++) {
+        formula.clauses.push_back({-in_hole(p, h), -in_hole(q, h)});
+      }
+    }
+  }
+}
+
+/*
+ * function to generate the Tseitin parity formula of a grid graph wrapped into
+ * a torus. every edge is a variable, and every vertex states that the parity of
+ * its edges equals its charge. only the first vertex is charged for an
+ * unsatisfiable formula, while no vertex is for a satisfiable one
+ * Arguments : width, height - the size of the grid, at least 3 each,
+ * satisfiable - if the formula is to be satisfiable, formula - to store the
+ * formula
+ */
+void generate_parity(int width, int height, bool satisfiable,
+                     Formula &formula) {
+  // the right edge of vertex (x, y) is 2 * (y * width + x) + 1 and its down
+  // edge follows it
+  auto right_edge = [width](int x, int y) { return 2 * (y * width + x) + 1; };
+  auto down_edge = [width](int x, int y) { return 2 * (y * width + x) + 2; };
+  formula.variable_count = 2 * width * height;
+  formula.clauses.clear();
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      int edges[] = {right_edge(x, y), down_edge(x, y),
+                     right_edge((x + width - 1) % width, y),
+                     down_edge(x, (y + height - 1) % height)};
+      int charge = (!satisfiable && x == 0 && y == 0) ? 1 : 0;
+      // forbid every assignment of the edges with the wrong parity
+      for (int signs = 0; signs < 16; signs++) {
+        int parity = __builtin_popcount(signs) % 2;
+        if (parity == charge) {
+          continue;
+        }
+        vector<int> clause;
+        for (int i = 0; i < 4; i++) {
+          clause.push_back(((signs >> i) & 1) ? -edges[i] : edges[i]);
+        }
+        formula.clauses.push_back(clause);
+      }
+    }
+  }
+}
+
+/*
+ * function to generate a bounded model checking formula of a binary counter,
+ * unrolled for a number of steps. the counter starts at 0 and is incremented
+ * by a ripple carry adder whenever a free enable input is set, and the formula
+ * asks if it can equal a target value within the steps. it is satisfiable if
+ * and only if the target is at most the number of steps
+ * Arguments : bit_count - the number of bits of the counter, step_count - the
+ * number of steps, target - the target value, below 2 to the bit_count,
+ * formula - to store the formula
+ */
+void generate_counter(int bit_count, int step_count, int target,
+                      Formula &formula) {
+  formula.clauses.clear();
+  int next_variable = 1;
+  // the bits of the counter at every step, from the least significant
+  vector<vector<int>> state(step_count + 1, vector<int>(bit_count));
+  for (int t = 0; t <= step_count; t++) {
+    for (int i = 0; i < bit_count; i++) {
+      state[t][i] = next_variable++;
+    }
+  }
+  for (int i = 0; i < bit_count; i++) {
+    formula.clauses.push_back({-state[0][i]});
+  }
+  for (int t = 0; t < step_count; t++) {
+    int carry = next_variable++; // the enable input is the first carry
+    for (int i = 0; i < bit_count; i++) {
+      int bit = state[t][i], next_bit = state[t + 1][i];
+      // next_bit is bit xor carry
+      formula.clauses.push_back({-next_bit, bit, carry});
+      formula.clauses.push_back({-next_bit, -bit, -carry});
+      formula.clauses.push_back({next_bit, -bit, carry});
+      formula.clauses.push_back({next_bit, bit, -carry});
+      if (i + 1 < bit_count) {
+        // the next carry is bit and carry
+        int next_carry = next_variable++;
+        formula.clauses.push_back({-next_carry, bit});
+        formula.clauses.push_back({-next_carry, carry});
+        formula.clauses.push_back({next_carry, -bit, -carry});
+        carry = next_carry;
+      }
+    }
+  }
+  // some step must reach the target, which its indicator variable enforces
+  vector<int> reached;
+  for (int t = 0; t <= step_count; t++) {
+    int indicator = next_variable++;
+    reached.push_back(indicator);
+    for (int i = 0; i < bit_count; i++) {
+      int bit = state[t][i];
+      formula.clauses.push_back({-indicator, ((target >> i) & 1) ? bit : -bit});
+    }
+  }
+  formula.clauses.push_back(reached);
+  formula.variable_count = next_variable - 1;
+}
+
+/*
+ * function to generate a formula of a family from its arguments, which are
+ *   random variables clauses clause_size seed
+ *   pigeonhole holes
+ *   parity width height satisfiable
+ *   counter bits steps target
+ * Arguments : family - the name of the family, arguments - its arguments,
+ * formula - to store the formula
+ * Return value : true, if the formula was generated, false, if the family is
+ * unknown or the arguments are wrong
+ */
+bool generate_family(const string &family, const vector<int> &arguments,
+                     Formula &formula) {
+  if (family == "random" && arguments.size() == 4 && arguments[0] > 0 &&
+      arguments[2] > 0) {
+    generate_random(arguments[0], arguments[1], arguments[2], arguments[3],
+                    formula);
+  } else if (family == "pigeonhole" && arguments.size() == 1 &&
+             arguments[0] > 0) {
+    generate_pigeonhole(arguments[0], formula);
+  } else if (family == "parity" && arguments.size() == 3 &&
+             arguments[0] >= 3 && arguments[1] >= 3) {
+    generate_parity(arguments[0], arguments[1], arguments[2] != 0, formula);
+  } else if (family == "counter" && arguments.size() == 3 &&
+             arguments[0] > 0 && arguments[0] < 31 && arguments[1] >= 0 &&
+             arguments[2] >= 0 && arguments[2] < (1 << arguments[0])) {
+    generate_counter(arguments[0], arguments[1], arguments[2], formula);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/*
+ * function to write a formula in DIMACS format
+ * Arguments : formula - the formula, output - the file to write to
+ */
+void write_dimacs(const Formula &formula, FILE *output) {
+  fprintf(output, "p cnf %d %d\n", formula.variable_count,
+          (int)formula.clauses.size());
+  for (int i = 0; i < formula.clauses.size(); i++) {
+    for (int j = 0; j < formula.clauses[i].size(); j++) {
+      fprintf(output, "%d ", formula.clauses[i][j]);
+    }
+    fprintf(output, "0\n");
+  }
+}
+
+/*
+ * function to check if an assignment satisfies every clause of a formula
+ * Arguments : formula - the formula, assignment - the value of every variable
+ * at its zero indexed position, 1 for true and 0 for false
+ * Return value : true, if yes, false, if no
+ */
+bool formula_satisfied(const Formula &formula, const vector<int> &assignment) {
+  for (int i = 0; i < formula.clauses.size(); i++) {
+    bool satisfied = false;
+    for (int j = 0; j < formula.clauses[i].size() && !satisfied; j++) {
+      int literal = formula.clauses[i][j];
+      int variable = abs(literal) - 1;
+      satisfied = variable < assignment.size() &&
+                  assignment[variable] == ((literal > 0) ? 1 : 0);
+    }
+    if (!satisfied) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+ * function to decide a formula by the DPLL algorithm, as a reference for
+ * small formulas
+ * Arguments : clauses - the clauses, simplified by the assignments so far
+ * Return value : true, if they are satisfiable, false, if not
+ */
+bool reference_satisfiable(vector<vector<int>> clauses) {
+  // propagate the unit clauses
+  while (true) {
+    int unit = 0;
+    for (int i = 0; i < clauses.size() && unit == 0; i++) {
+      if (clauses[i].empty()) {
+        return false;
+      } else if (clauses[i].size() == 1) {
+        unit = clauses[i][0];
+      }
+    }
+    if (unit == 0) {
+      break;
+    }
+    vector<vector<int>> simplified;
+    for (int i = 0; i < clauses.size(); i++) {
+      vector<int> clause;
+      bool satisfied = false;
+      for (int j = 0; j < clauses[i].size(); j++) {
+        satisfied = satisfied || clauses[i][j] == unit;
+        if (clauses[i][j] != -unit) {
+          clause.push_back(clauses[i][j]);
+        }
+      }
+      if (!satisfied) {
+        simplified.push_back(clause);
+      }
+    }
+    clauses.swap(simplified);
+  }
+  if (clauses.empty()) {
+    return true;
+  }
+  // branch on the first literal of the first clause
+  int literal = clauses[0][0];
+  for (int polarity = 0; polarity < 2; polarity++) {
+    vector<vector<int>> branch = clauses;
+    branch.push_back({(polarity == 0) ? literal : -literal});
+    if (reference_satisfiable(branch)) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,38 @@
+/*
+ * Generators of CNF formulas from the families used to benchmark and check the
+ * SAT solver
+ */
+
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/*
+ * structure to store a formula in conjunctive normal form, with the clauses
+ * made of one indexed signed literals as in DIMACS
+ */
+struct Formula {
+  int variable_count = 0;
+  std::vector<std::vector<int>> clauses;
+};
+
+// to generate a random formula with clauses of a fixed length
+void generate_random(int, int, int, int, Formula &);
+// to generate the pigeonhole formula with one pigeon more than holes
+void generate_pigeonhole(int, Formula &);
+// to generate the parity formula of a grid graph
+void generate_parity(int, int, bool, Formula &);
+// to generate a bounded model checking formula of a counter
+void generate_counter(int, int, int, Formula &);
+// to generate a formula of a family from its arguments
+bool generate_family(const std::string &, const std::vector<int> &, Formula &);
+void write_dimacs(const Formula &, FILE *); // to write a formula in DIMACS
+// to check if an assignment satisfies a formula
+bool formula_satisfied(const Formula &, const std::vector<int> &);
+// to decide a small formula by the DPLL algorithm, as a reference
+bool reference_satisfiable(std::vector<std::vector<int>>);
+
+#endif
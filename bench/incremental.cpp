@@ -0,0 +1,199 @@
+/*
+ * Program to check the solver used as a library. it adds the clauses of small
+ * random formulas a few at a time, solves under random assumptions between
+ * the additions, and checks every answer against the reference solver, every
+ * model against the clauses and the assumptions, and every set of failed
+ * assumptions, which must be assumptions that are unsatisfiable with the
+ * clauses on their own. it also checks that literals of 0 or out of range are
+ * refused, and that a search stopped by a budget or an interrupt leaves the
+ * solver able to answer the next call
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../solver.h"
+#include "generator.h"
+
+using namespace std;
+
+/*
+ * function to check a call to solve with assumptions
+ * Arguments : solver - the solver, after the call, result - what the call
+ * returned, clauses - the clauses added so far, assumptions - the assumed
+ * literals
+ * Return value : an empty string if the call was right, or what is wrong
+ */
+string check_call(SATSolverCDCL &solver, int result,
+                  const vector<vector<int>> &clauses,
+                  const vector<int> &assumptions) {
+  vector<vector<int>> assumed = clauses;
+  for (int i = 0; i < assumptions.size(); i++) {
+    assumed.push_back({assumptions[i]});
+  }
+  bool satisfiable = reference_satisfiable(assumed);
+  if (result != (satisfiable ? RetVal::r_satisfied : RetVal::r_unsatisfied)) {
+    return satisfiable ? "EXPECTED SAT" : "EXPECTED UNSAT";
+  }
+  if (satisfiable) {
+    for (int i = 0; i < assumed.size(); i++) {
+      bool satisfied = false;
+      for (int j = 0; j < assumed[i].size(); j++) {
+        satisfied = satisfied || solver.get_model_value(assumed[i][j]) == 1;
+      }
+      if (!satisfied) {
+        return "WRONG MODEL";
+      }
+    }
+    return "";
+  }
+  const vector<int> &failed = solver.get_failed_assumptions();
+  vector<vector<int>> core = clauses;
+  for (int i = 0; i < failed.size(); i++) {
+    if (find(assumptions.begin(), assumptions.end(), failed[i]) ==
+        assumptions.end()) {
+      return "FAILED LITERAL THAT WAS NOT ASSUMED";
+    }
+    core.push_back({failed[i]});
+  }
+  if (reference_satisfiable(core)) {
+    return "FAILED ASSUMPTIONS THAT ARE SATISFIABLE";
+  }
+  return "";
+}
+
+/*
+ * function to check that clauses and assumptions with a literal of 0 or out of
+ * range are refused without changing the solver
+ * Return value : the number of wrong results
+ */
+int check_invalid_literals() {
+  const vector<int> invalid_literals = {0, INT_MIN, INT_MAX, -INT_MAX};
+  SATSolverCDCL solver;
+  solver.add_clause({1, 2});
+  int wrong_count = 0;
+  for (int i = 0; i < invalid_literals.size(); i++) {
+    if (solver.add_clause({1, invalid_literals[i]}) != RetVal::r_unknown ||
+        solver.solve({invalid_literals[i]}) != RetVal::r_unknown) {
+      printf("literal %d was not refused\n", invalid_literals[i]);
+      wrong_count++;
+    }
+  }
+  if (solver.solve({-1}) != RetVal::r_satisfied ||
+      solver.get_model_value(2) != 1) {
+    printf("the solver changed after refusing literals\n");
+    wrong_count++;
+  }
+  return wrong_count;
+}
+
+/*
+ * function to check that a conflict budget and interrupt() stop the search
+ * with RetVal::r_unknown, and that the solver answers right once the budget
+ * is lifted and clear_interrupt() is called
+ * Return value : the number of wrong results
+ */
+int check_stopped_searches() {
+  Formula formula;
+  generate_pigeonhole(8, formula); // unsatisfiable, in about 10000 conflicts
+  SATSolverCDCL solver;
+  solver.set_seed(1);
+  for (int i = 0; i < formula.clauses.size(); i++) {
+    solver.add_clause(formula.clauses[i]);
+  }
+  int wrong_count = 0;
+  solver.set_conflict_budget(1);
+  if (solver.solve(vector<int>()) != RetVal::r_unknown) {
+    printf("the conflict budget did not stop the search\n");
+    wrong_count++;
+  }
+  solver.set_conflict_budget(0);
+  solver.interrupt();
+  if (solver.solve(vector<int>()) != RetVal::r_unknown) {
+    printf("the search was not stopped by an earlier interrupt\n");
+    wrong_count++;
+  }
+  solver.clear_interrupt();
+  // interrupt from another thread while the search runs, which may also
+  // finish first
+  thread interrupter([&solver]() {
+    this_thread::sleep_for(chrono::milliseconds(10));
+    solver.interrupt();
+  });
+  int result = solver.solve(vector<int>());
+  interrupter.join();
+  if (result != RetVal::r_unknown && result != RetVal::r_unsatisfied) {
+    printf("the interrupted search returned %d\n", result);
+    wrong_count++;
+  }
+  solver.clear_interrupt();
+  if (solver.solve(vector<int>()) != RetVal::r_unsatisfied) {
+    printf("the solver was wrong after clear_interrupt()\n");
+    wrong_count++;
+  }
+  return wrong_count;
+}
+
+/*
+ * the main() function
+ */
+int main(int argc, char *argv[]) {
+  const int steps = 6;      // additions of clauses to every formula
+  const int call_count = 4; // calls to solve after every addition
+  int formula_count = 200;
+  if (argc >= 2) {
+    formula_count = atoi(argv[1]);
+  }
+  if (formula_count <= 0) {
+    cerr << "Usage: " << argv[0] << " [formula_count]" << endl;
+    return 1;
+  }
+  int wrong_count = 0;
+  for (int seed = 0; seed < formula_count; seed++) {
+    // formulas a bit below the threshold, so that the assumptions decide
+    // whether they are satisfiable
+    Formula formula;
+    int variable_count = 8 + seed % 23;
+    generate_random(variable_count, variable_count * 4 - 2 * (seed % 5), 3,
+                    seed, formula);
+    mt19937 generator(seed);
+    SATSolverCDCL solver;
+    solver.set_seed(seed);
+    vector<vector<int>> clauses;
+    for (int step = 1; step <= steps; step++) {
+      while (clauses.size() < formula.clauses.size() * step / steps) {
+        clauses.push_back(formula.clauses[clauses.size()]);
+        solver.add_clause(clauses.back());
+      }
+      for (int call = 0; call < call_count; call++) {
+        vector<int> assumptions;
+        int assumption_count = generator() % 6;
+        for (int i = 0; i < assumption_count; i++) {
+          int variable = generator() % variable_count + 1;
+          assumptions.push_back((generator() % 2 == 0) ? variable : -variable);
+        }
+        int result = solver.solve(assumptions);
+        string problem = check_call(solver, result, clauses, assumptions);
+        if (!problem.empty()) {
+          printf("formula %d after %d clauses, call %d: %s\n", seed,
+                 (int)clauses.size(), call, problem.c_str());
+          wrong_count++;
+        }
+      }
+    }
+  }
+  wrong_count += check_invalid_literals();
+  wrong_count += check_stopped_searches();
+  printf("checked %d formulas with %d calls each, invalid literals, and "
+         "stopped searches, %d wrong results\n",
+         formula_count, steps * call_count, wrong_count);
+  return (wrong_count > 0) ? 1 : 0;
+}
@@ -0,0 +1,292 @@
+/*
+ * Program to measure the speed of unit propagation with the two encodings of
+ * literals the solver has used: one indexed signed literals with the values
+ * stored per variable, and packed literals with the values stored per
+ * literal. both run the same two watched literal propagation on the same
+ * formula with the same decisions, so that only the encoding differs
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "generator.h"
+
+using namespace std;
+
+/*
+ * the encoding of the solver before packing, where a literal is one indexed
+ * and signed, and every access to its value or its watch list converts it and
+ * branches on its sign
+ */
+struct SignedEncoding {
+  vector<int> values; // 1, 0 or -1 for every variable
+
+  void resize(int variable_count) { values.assign(variable_count, -1); }
+  static int encode(int literal) { return literal; }
+  static int negate(int literal) { return -literal; }
+  static int variable(int literal) {
+    return (literal > 0) ? literal - 1 : -literal - 1;
+  }
+  static int watch_index(int literal) {
+    return (literal > 0) ? 2 * (literal - 1) : 2 * (-literal - 1) + 1;
+  }
+  int value(int literal) {
+    int value = values[variable(literal)];
+    if (value == -1) {
+      return -1;
+    }
+    return (literal > 0) ? value : 1 - value;
+  }
+  void assign(int literal) { values[variable(literal)] = (literal > 0); }
+  void unassign(int literal) { values[variable(literal)] = -1; }
+};
+
+/*
+ * the packed encoding of the solver, where the literal v is 2 * (v - 1) and -v
+ * is 2 * (v - 1) + 1, and a byte holds the value of every literal
+ */
+struct PackedEncoding {
+  vector<int8_t> values; // 1, 0 or -1 for every literal
+
+  void resize(int variable_count) { values.assign(2 * variable_count, -1); }
+  static int encode(int literal) {
+    return (literal > 0) ? 2 * (literal - 1) : 2 * (-literal - 1) + 1;
+  }
+  static int negate(int literal) { return literal ^ 1; }
+  static int variable(int literal) { return literal >> 1; }
+  static int watch_index(int literal) { return literal; }
+  int value(int literal) { return values[literal]; }
+  void assign(int literal) {
+    values[literal] = 1;
+    values[literal ^ 1] = 0;
+  }
+  void unassign(int literal) {
+    values[literal] = -1;
+    values[literal ^ 1] = -1;
+  }
+};
+
+/*
+ * class to propagate a formula with two watched literals, as the solver does,
+ * for an encoding of the literals. the clauses are stored contiguously, and
+ * unit clauses are left out
+ */
+template <class Encoding> class Propagator {
+private:
+  Encoding encoding;
+  int variable_count;
+  vector<int> literals;     // the literals of all clauses
+  vector<int> clause_start; // start of every clause, and the end of the last
+  vector<vector<int>> watch_list; // watching clauses of every literal
+  vector<int> trail;              // the assigned literals
+  int propagation_head;           // next trail literal to propagate
+  long long propagation_count;    // number of literals propagated
+
+  int *clause_literals(int clause) { return &literals[clause_start[clause]]; }
+  bool propagate();
+
+public:
+  Propagator(const Formula &);                // constructor
+  long long run(int, unsigned int, double &); // to time the rounds
+};
+
+/*
+ * the constructor, which stores and watches the clauses of the formula
+ * Arguments : formula - the formula
+ */
+template <class Encoding>
+Propagator<Encoding>::Propagator(const Formula &formula)
+    : variable_count(formula.variable_count), propagation_head(0),
+      propagation_count(0) {
+  encoding.resize(variable_count);
+  watch_list.resize(2 * variable_count);
+  for (int i = 0; i < formula.clauses.size(); i++) {
+    if (formula.clauses[i].size() < 2) {
+      continue;
+    }
+    int clause = clause_start.size();
+    clause_start.push_back(literals.size());
+    for (int j = 0; j < formula.clauses[i].size(); j++) {
+      literals.push_back(Encoding::encode(formula.clauses[i][j]));
+    }
+    watch_list[Encoding::watch_index(literals[clause_start[clause]])]
+        .push_back(clause);
+    watch_list[Encoding::watch_index(literals[clause_start[clause] + 1])]
+        .push_back(clause);
+  }
+  clause_start.push_back(literals.size());
+}
+
+/*
+ * function to propagate the literals on the trail that have not been
+ * propagated yet, with the same loop as the solver
+ * Return value : false if a clause became false, true otherwise
+ */
+template <class Encoding> bool Propagator<Encoding>::propagate() {
+  while (propagation_head < trail.size()) {
+    int false_literal = Encoding::negate(trail[propagation_head++]);
+    propagation_count++;
+    vector<int> &watchers = watch_list[Encoding::watch_index(false_literal)];
+    int kept = 0;
+    for (int i = 0; i < watchers.size(); i++) {
+      int clause_index = watchers[i];
+      int *clause = clause_literals(clause_index);
+      int size = clause_start[clause_index + 1] - clause_start[clause_index];
+      if (clause[0] == false_literal) {
+        swap(clause[0], clause[1]);
+      }
+      if (encoding.value(clause[0]) == 1) {
+        watchers[kept++] = clause_index;
+        continue;
+      }
+      bool new_watch_found = false;
+      for (int j = 2; j < size; j++) {
+        if (encoding.value(clause[j]) != 0) {
+          swap(clause[1], clause[j]);
+          watch_list[Encoding::watch_index(clause[1])].push_back(clause_index);
+          new_watch_found = true;
+          break;
+        }
+      }
+      if (new_watch_found) {
+        continue;
+      }
+      watchers[kept++] = clause_index;
+      if (encoding.value(clause[0]) == 0) {
+        for (i++; i < watchers.size(); i++) {
+          watchers[kept++] = watchers[i];
+        }
+        watchers.resize(kept);
+        return false;
+      }
+      encoding.assign(clause[0]);
+      trail.push_back(clause[0]);
+    }
+    watchers.resize(kept);
+  }
+  return true;
+}
+
+/*
+ * function to run rounds of random decisions. every round decides the
+ * variables in a random order with random values, propagating after each. a
+ * decision that gives a conflict is undone with what it implied, and the
+ * round goes on until every variable is assigned or refuted, after which all
+ * of it is undone
+ * Arguments : rounds - the number of rounds, seed - the seed of the decisions,
+ * seconds - to store the time taken
+ * Return value : the number of literals propagated
+ */
+template <class Encoding>
+long long Propagator<Encoding>::run(int rounds, unsigned int seed,
+                                    double &seconds) {
+  mt19937 generator(seed);
+  vector<int> order(variable_count);
+  for (int i = 0; i < variable_count; i++) {
+    order[i] = i + 1;
+  }
+  propagation_count = 0;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (int round = 0; round < rounds; round++) {
+    shuffle(order.begin(), order.end(), generator);
+    for (int i = 0; i < variable_count; i++) {
+      int literal = (generator() & 1) ? order[i] : -order[i];
+      int decision = Encoding::encode(literal);
+      if (encoding.value(decision) != -1) {
+        continue;
+      }
+      int decision_start = trail.size();
+      encoding.assign(decision);
+      trail.push_back(decision);
+      if (!propagate()) {
+        for (int j = decision_start; j < trail.size(); j++) {
+          encoding.unassign(trail[j]);
+        }
+        trail.resize(decision_start);
+        propagation_head = decision_start;
+      }
+    }
+    for (int i = 0; i < trail.size(); i++) {
+      encoding.unassign(trail[i]);
+    }
+    trail.clear();
+    propagation_head = 0;
+  }
+  seconds =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  return propagation_count;
+}
+
+/*
+ * function to print a line of the results of an encoding
+ * Arguments : name - the name of the encoding, seconds - the fastest time of
+ * a run, propagations - the literals propagated in a run
+ * Return value : the propagations per second
+ */
+double report(const char *name, double seconds, long long propagations) {
+  double rate = propagations / max(seconds, 1e-9);
+  printf("%-8s %9.3f %14lld %12.2f\n", name, seconds, propagations,
+         rate / 1e6);
+  return rate;
+}
+
+/*
+ * the main() function
+ */
+int main(int argc, char *argv[]) {
+  const int repetitions = 5; // runs of every encoding, of which the fastest
+                             // is kept, since the timings are noisy
+  string family = "counter";
+  vector<int> arguments = {14, 1000, 0};
+  int rounds = 20;
+  if (argc >= 2) {
+    rounds = atoi(argv[1]);
+  }
+  if (argc >= 3) {
+    family = argv[2];
+    arguments.clear();
+    for (int i = 3; i < argc; i++) {
+      arguments.push_back(atoi(argv[i]));
+    }
+  }
+  Formula formula;
+  if (rounds <= 0 || !generate_family(family, arguments, formula)) {
+    cerr << "Usage: " << argv[0] << " [rounds [family arguments...]]" << endl;
+    return 1;
+  }
+  printf("%s formula with %d variables and %d clauses, %d rounds, best of "
+         "%d runs\n",
+         family.c_str(), formula.variable_count, (int)formula.clauses.size(),
+         rounds, repetitions);
+  // the runs of the two encodings alternate, so that both see the same
+  // conditions of the machine
+  Propagator<SignedEncoding> signed_propagator(formula);
+  Propagator<PackedEncoding> packed_propagator(formula);
+  double signed_seconds = 1e100, packed_seconds = 1e100, seconds;
+  long long signed_propagations = 0, packed_propagations = 0;
+  for (int i = 0; i < repetitions; i++) {
+    signed_propagations = signed_propagator.run(rounds, 1, seconds);
+    signed_seconds = min(signed_seconds, seconds);
+    packed_propagations = packed_propagator.run(rounds, 1, seconds);
+    packed_seconds = min(packed_seconds, seconds);
+  }
+  if (signed_propagations != packed_propagations) {
+    cerr << "The encodings propagated differently" << endl;
+    return 1;
+  }
+  printf("%-8s %9s %14s %12s\n", "encoding", "seconds", "propagations",
+         "Mprops/s");
+  double signed_rate =
+      report("signed", signed_seconds, signed_propagations);
+  double packed_rate =
+      report("packed", packed_seconds, packed_propagations);
+  printf("speedup %.2fx\n", packed_rate / signed_rate);
+  return 0;
+}
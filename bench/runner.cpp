@@ -0,0 +1,1005 @@
+/*
+ * Program to benchmark the SAT solver and check its answers. in the benchmark
+ * mode, it solves the instances of a suite, checks every result, and compares
+ * the time taken with a stored baseline. in the check mode, it solves many
+ * small random formulas with several configurations of the solver and checks
+ * every result against a reference solver, solves a few larger formulas long
+ * enough to reach the periodic work of the search, checks the proofs of
+ * unsatisfiability, and solves all the formulas again as a batch
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <lzma.h>
+#include <map>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include <zlib.h>
+
+#include "generator.h"
+
+using namespace std;
+
+const char *instance_directory = "bench/instances"; // generated formulas
+const int time_limit = 300; // seconds of CPU time allowed for every run
+const double slower_ratio = 1.5; // slowdown over the baseline that is
+                                  // reported as a regression
+const double noise_seconds = 0.2; // differences below this are ignored
+const int repetitions = 3; // runs of every instance, of which the median is
+                           // kept, since the timings are noisy
+const char *solver_seed = "1"; // seed of every run, since the time taken by
+                               // an instance varies widely with the seed
+bool statistics_supported = true; // if the solver was built with statistics
+
+/*
+ * structure to store the outcome of running the solver once
+ */
+struct Run {
+  string result;           // SAT, UNSAT, or what went wrong
+  vector<int> assignment;  // the model, 1 for true and 0 for false
+  double seconds = 0;      // wall clock time
+  long long peak_rss = 0;  // peak resident set size in kilobytes
+  long long conflicts = 0; // from the solver statistics, if available
+  long long propagations = 0;
+};
+
+/*
+ * structure to store the numbers of an instance in the baseline
+ */
+struct Baseline {
+  double seconds;
+  long long conflicts, propagations, peak_rss;
+};
+
+/*
+ * function to read a number that follows a key in a JSON object
+ * Arguments : json - the text of the object, key - the key
+ * Return value : the number, or 0 if the key is absent
+ */
+long long json_number(const string &json, const string &key) {
+  size_t position = json.find("\"" + key + "\":");
+  if (position == string::npos) {
+    return 0;
+  }
+  return atoll(json.c_str() + position + key.size() + 3);
+}
+
+/*
+ * function to run the solver, with its output redirected to a file and its
+ * errors discarded
+ * Arguments : arguments - the path of the solver and its arguments,
+ * output_path - the file for the output, run - to store the time, the peak
+ * memory, and TIMEOUT or CRASH if the solver did not exit normally,
+ * input_path - a file to pass to the solver's standard input through a pipe,
+ * or an empty string for none
+ * Return value : true, if the solver exited with status 0, false, if not
+ */
+bool execute_solver(const vector<string> &arguments, const string &output_path,
+                    Run &run, const string &input_path = "") {
+  fflush(stdout); // the child must not repeat what is buffered
+  int input_pipe[2] = {-1, -1};
+  if (!input_path.empty() && pipe(input_pipe) != 0) {
+    run.result = "NO PIPE";
+    return false;
+  }
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  pid_t child = fork();
+  if (child == 0) {
+    // limit the CPU time, and send the output to the file and errors away
+    struct rlimit limit = {(rlim_t)time_limit, (rlim_t)time_limit};
+    setrlimit(RLIMIT_CPU, &limit);
+    freopen(output_path.c_str(), "w", stdout);
+    freopen("/dev/null", "w", stderr);
+    signal(SIGPIPE, SIG_DFL); // the runner ignores it
+    if (input_pipe[0] != -1) {
+      dup2(input_pipe[0], STDIN_FILENO);
+      close(input_pipe[0]);
+      close(input_pipe[1]);
+    }
+    vector<char *> argv;
+    for (int i = 0; i < arguments.size(); i++) {
+      argv.push_back((char *)arguments[i].c_str());
+    }
+    argv.push_back(nullptr);
+    execv(argv[0], argv.data());
+    _exit(127);
+  }
+  if (input_pipe[0] != -1) {
+    // the solver reads while the file is written, so the pipe cannot fill up
+    close(input_pipe[0]);
+    ifstream input(input_path, ios::binary);
+    char buffer[1 << 16];
+    bool open = true;
+    while (open && input.read(buffer, sizeof(buffer)).gcount() > 0) {
+      open = write(input_pipe[1], buffer, input.gcount()) == input.gcount();
+    }
+    close(input_pipe[1]);
+  }
+  int status;
+  struct rusage usage;
+  wait4(child, &status, 0, &usage);
+  run.seconds =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  run.peak_rss = usage.ru_maxrss;
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    run.result = WIFSIGNALED(status) && WTERMSIG(status) == SIGXCPU
+                     ? "TIMEOUT"
+                     : "CRASH";
+    return false;
+  }
+  return true;
+}
+
+/*
+ * function to find if the solver was built with statistics, by asking for
+ * them on a formula of one clause, since a build without them refuses the
+ * option
+ * Arguments : solver - the path of the solver
+ * Return value : true, if it reports statistics, false, if not
+ */
+bool solver_has_statistics(const string &solver) {
+  string cnf_path = string(instance_directory) + "/statistics.cnf";
+  string statistics_path = string(instance_directory) + "/statistics.json";
+  FILE *cnf = fopen(cnf_path.c_str(), "w");
+  fprintf(cnf, "p cnf 1 1\n1 0\n");
+  fclose(cnf);
+  Run run;
+  return execute_solver({solver, cnf_path, "--stats-json", statistics_path},
+                        string(instance_directory) + "/output.txt", run);
+}
+
+/*
+ * function to run the solver on a formula, with its output redirected to a
+ * file, and to read its result and, if the build has them, its statistics
+ * Arguments : solver - the path of the solver, options - its options,
+ * cnf_path - the formula, formula - the formula in memory, run - to store the
+ * outcome, piped - true to pass the formula through a pipe to the solver's
+ * standard input instead of by its path
+ */
+void run_solver(const string &solver, const vector<string> &options,
+                const string &cnf_path, const Formula &formula, Run &run,
+                bool piped = false) {
+  string output_path = string(instance_directory) + "/output.txt";
+  string statistics_path = string(instance_directory) + "/statistics.json";
+  remove(statistics_path.c_str());
+  vector<string> arguments = {solver, "--seed", solver_seed};
+  if (!piped) {
+    arguments.push_back(cnf_path);
+  }
+  if (statistics_supported) {
+    arguments.push_back("--stats-json");
+    arguments.push_back(statistics_path);
+  }
+  arguments.insert(arguments.end(), options.begin(), options.end());
+  run.assignment.assign(formula.variable_count, 0);
+  if (!execute_solver(arguments, output_path, run, piped ? cnf_path : "")) {
+    return;
+  }
+  ifstream output(output_path);
+  output >> run.result;
+  int literal;
+  while (run.result == "SAT" && output >> literal && literal != 0) {
+    if (abs(literal) <= formula.variable_count) {
+      run.assignment[abs(literal) - 1] = (literal > 0) ? 1 : 0;
+    }
+  }
+  ifstream statistics(statistics_path);
+  stringstream json;
+  json << statistics.rdbuf();
+  run.conflicts = json_number(json.str(), "conflicts");
+  run.propagations = json_number(json.str(), "propagations");
+}
+
+/*
+ * function to check the result of a run
+ * Arguments : formula - the formula, run - the outcome of the run, expected -
+ * SAT, UNSAT or UNKNOWN, or ? if SAT and UNSAT are both acceptable
+ * Return value : an empty string if the result is right, or what is wrong
+ */
+string check_run(const Formula &formula, const Run &run,
+                 const string &expected) {
+  if (run.result != "SAT" && run.result != "UNSAT") {
+    return (run.result == expected) ? "" : run.result;
+  }
+  if (run.result == "SAT" && !formula_satisfied(formula, run.assignment)) {
+    return "WRONG MODEL";
+  }
+  if (expected != "?" && run.result != expected) {
+    return "EXPECTED " + expected;
+  }
+  return "";
+}
+
+/*
+ * function to read the baseline, with a line per instance holding its name,
+ * seconds, conflicts, propagations and peak resident set size
+ * Arguments : path - the path of the baseline, baseline - to store it
+ */
+void read_baseline(const string &path, map<string, Baseline> &baseline) {
+  ifstream input(path);
+  string line;
+  while (getline(input, line)) {
+    istringstream fields(line);
+    string name;
+    Baseline numbers;
+    if (line.empty() || line[0] == '#' ||
+        !(fields >> name >> numbers.seconds >> numbers.conflicts >>
+          numbers.propagations >> numbers.peak_rss)) {
+      continue;
+    }
+    baseline[name] = numbers;
+  }
+}
+
+/*
+ * function to solve every instance of a suite, check the results and compare
+ * the times with the baseline, or write a new baseline
+ * Arguments : solver - the path of the solver, suite_path - the suite,
+ * baseline_path - the baseline, write_baseline - true to write the baseline
+ * instead of comparing with it
+ * Return value : 0 if every result is right and nothing is slower than the
+ * baseline, 1 otherwise
+ */
+int run_benchmarks(const string &solver, const string &suite_path,
+                   const string &baseline_path, bool write_baseline) {
+  map<string, Baseline> baseline;
+  if (!write_baseline) {
+    read_baseline(baseline_path, baseline);
+  }
+  ifstream suite(suite_path);
+  if (!suite) {
+    cerr << "Could not open " << suite_path << endl;
+    return 1;
+  }
+  ostringstream new_baseline;
+  new_baseline << "# name seconds conflicts propagations peak_rss_kb" << endl;
+  printf("%-18s %-6s %9s %12s %14s %9s %9s  %s\n", "instance", "result",
+         "seconds", "conflicts/s", "propagations/s", "rss_MB", "baseline",
+         "status");
+  int wrong_count = 0, slower_count = 0;
+  double total_seconds = 0, total_baseline_seconds = 0;
+  string line;
+  while (getline(suite, line)) {
+    istringstream fields(line);
+    string name, family, word;
+    vector<string> words;
+    if (line.empty() || line[0] == '#' || !(fields >> name >> family)) {
+      continue;
+    }
+    while (fields >> word) {
+      words.push_back(word);
+    }
+    string expected = words.empty() ? "?" : words.back();
+    vector<int> arguments;
+    for (int i = 0; i + 1 < words.size(); i++) {
+      arguments.push_back(atoi(words[i].c_str()));
+    }
+    Formula formula;
+    if (!generate_family(family, arguments, formula)) {
+      cerr << "Wrong instance in the suite: " << line << endl;
+      return 1;
+    }
+    string cnf_path = string(instance_directory) + "/" + name + ".cnf";
+    FILE *cnf = fopen(cnf_path.c_str(), "w");
+    write_dimacs(formula, cnf);
+    fclose(cnf);
+
+    // every run is checked, and the run with the median time is reported
+    vector<Run> runs(repetitions);
+    string problem;
+    for (int i = 0; i < repetitions && problem.empty(); i++) {
+      run_solver(solver, {}, cnf_path, formula, runs[i]);
+      problem = check_run(formula, runs[i], expected);
+      if (!problem.empty()) {
+        runs[0] = runs[i];
+        runs.resize(1);
+      }
+    }
+    sort(runs.begin(), runs.end(),
+         [](const Run &a, const Run &b) { return a.seconds < b.seconds; });
+    Run &run = runs[runs.size() / 2];
+    string status = problem.empty() ? "ok" : problem;
+    string baseline_seconds = "-";
+    if (!problem.empty()) {
+      wrong_count++;
+    } else if (baseline.count(name)) {
+      double previous = baseline[name].seconds;
+      char text[32];
+      snprintf(text, sizeof(text), "%.3f", previous);
+      baseline_seconds = text;
+      total_seconds += run.seconds;
+      total_baseline_seconds += previous;
+      if (run.seconds > previous * slower_ratio &&
+          run.seconds - previous > noise_seconds) {
+        status = "SLOWER";
+        slower_count++;
+      }
+    }
+    double seconds = max(run.seconds, 1e-6);
+    printf("%-18s %-6s %9.3f %12.0f %14.0f %9.1f %9s  %s\n", name.c_str(),
+           run.result.c_str(), run.seconds, run.conflicts / seconds,
+           run.propagations / seconds, run.peak_rss / 1024.0,
+           baseline_seconds.c_str(), status.c_str());
+    fflush(stdout);
+    new_baseline << name << " " << run.seconds << " " << run.conflicts << " "
+                 << run.propagations << " " << run.peak_rss << endl;
+  }
+  if (write_baseline) {
+    ofstream output(baseline_path);
+    output << new_baseline.str();
+    printf("wrote %s\n", baseline_path.c_str());
+  } else if (total_baseline_seconds > 0) {
+    printf("total %.3f s against %.3f s in the baseline (%+.1f%%)\n",
+           total_seconds, total_baseline_seconds,
+           100 * (total_seconds / total_baseline_seconds - 1));
+  }
+  printf("%d wrong results, %d slower than the baseline\n", wrong_count,
+         slower_count);
+  return (wrong_count > 0 || slower_count > 0) ? 1 : 0;
+}
+
+/*
+ * structure to check a DRAT proof forward, by checking that every clause it
+ * adds follows from the clauses so far by unit propagation. this is the RUP
+ * part of DRAT, which covers every clause the solver adds
+ */
+struct ProofChecker {
+  vector<vector<int>> clauses;  // every clause so far, with distinct literals
+  vector<char> clause_deleted;  // if each clause was deleted
+  map<vector<int>, vector<int>> clause_indices; // the clauses alive for
+                                                // every set of literals
+  vector<vector<int>> watches;  // clauses watching every literal
+  vector<int> units;            // the unit clauses alive
+  int empty_count = 0;          // number of empty clauses alive
+  vector<int> values;           // 1, 0 or -1 for every variable
+  vector<int> trail;            // literals assigned, in order
+
+  ProofChecker(int variable_count)
+      : watches(2 * variable_count + 2), values(variable_count + 1, 0) {}
+
+  static int watch_index(int literal) {
+    return (literal > 0) ? 2 * literal : -2 * literal + 1;
+  }
+  int value(int literal) {
+    return (literal > 0) ? values[literal] : -values[-literal];
+  }
+
+  /*
+   * function to get a clause in the form it is stored and looked up in
+   * Arguments : literals - the literals
+   * Return value : the literals sorted, without repetitions
+   */
+  static vector<int> normalize(vector<int> literals) {
+    sort(literals.begin(), literals.end());
+    literals.erase(unique(literals.begin(), literals.end()), literals.end());
+    return literals;
+  }
+
+  /*
+   * function to add a clause
+   * Arguments : literals - the literals of the clause
+   */
+  void add(const vector<int> &literals) {
+    vector<int> clause = normalize(literals);
+    int index = clauses.size();
+    clause_indices[clause].push_back(index);
+    if (clause.empty()) {
+      empty_count++;
+    } else if (clause.size() == 1) {
+      units.push_back(index);
+    } else {
+      watches[watch_index(clause[0])].push_back(index);
+      watches[watch_index(clause[1])].push_back(index);
+    }
+    clauses.push_back(clause);
+    clause_deleted.push_back(0);
+  }
+
+  /*
+   * function to delete a clause, which stays in the watch lists until they
+   * are next visited
+   * Arguments : literals - the literals of the clause
+   * Return value : true, if the clause was alive, false, if not
+   */
+  bool remove(const vector<int> &literals) {
+    map<vector<int>, vector<int>>::iterator found =
+        clause_indices.find(normalize(literals));
+    if (found == clause_indices.end() || found->second.empty()) {
+      return false;
+    }
+    int index = found->second.back();
+    found->second.pop_back();
+    clause_deleted[index] = 1;
+    if (clauses[index].empty()) {
+      empty_count--;
+    } else if (clauses[index].size() == 1) {
+      units.erase(find(units.begin(), units.end(), index));
+    }
+    return true;
+  }
+
+  /*
+   * function to assign a literal to true
+   * Arguments : literal - the literal
+   * Return value : false, if the literal is already false, true, if not
+   */
+  bool assign(int literal) {
+    if (value(literal) != 0) {
+      return value(literal) == 1;
+    }
+    values[abs(literal)] = (literal > 0) ? 1 : -1;
+    trail.push_back(literal);
+    return true;
+  }
+
+  /*
+   * function to check if a clause follows from the clauses alive by unit
+   * propagation, that is if propagating the units and the negation of the
+   * clause leads to a conflict
+   * Arguments : literals - the literals of the clause
+   * Return value : true, if it follows, false, if not
+   */
+  bool implied(const vector<int> &literals) {
+    bool conflict = empty_count > 0;
+    for (int i = 0; i < units.size(); i++) {
+      conflict = !assign(clauses[units[i]][0]) || conflict;
+    }
+    for (int i = 0; i < literals.size(); i++) {
+      conflict = !assign(-literals[i]) || conflict;
+    }
+    for (int head = 0; head < trail.size() && !conflict; head++) {
+      int falsified = -trail[head];
+      vector<int> &watch = watches[watch_index(falsified)];
+      int kept = 0;
+      for (int i = 0; i < watch.size(); i++) {
+        int index = watch[i];
+        if (clause_deleted[index]) {
+          continue; // drop the watch of a deleted clause
+        }
+        vector<int> &clause = clauses[index];
+        if (conflict || (clause[0] != falsified && value(clause[0]) == 1) ||
+            (clause[1] != falsified && value(clause[1]) == 1)) {
+          watch[kept++] = index;
+          continue;
+        }
+        if (clause[0] == falsified) {
+          swap(clause[0], clause[1]);
+        }
+        int j = 2;
+        while (j < clause.size() && value(clause[j]) == -1) {
+          j++;
+        }
+        if (j < clause.size()) {
+          swap(clause[1], clause[j]); // watch another literal
+          watches[watch_index(clause[1])].push_back(index);
+          continue;
+        }
+        watch[kept++] = index;
+        conflict = !assign(clause[0]);
+      }
+      watch.resize(kept);
+    }
+    for (int i = 0; i < trail.size(); i++) {
+      values[abs(trail[i])] = 0;
+    }
+    trail.clear();
+    return conflict;
+  }
+};
+
+/*
+ * function to check the DRAT proof the solver wrote for an unsatisfiable
+ * formula, in the text or the binary format
+ * Arguments : formula - the formula, proof_path - the proof, binary - true if
+ * it is in the binary format
+ * Return value : an empty string if the proof is right, or what is wrong
+ */
+string check_proof(const Formula &formula, const string &proof_path,
+                   bool binary) {
+  ProofChecker checker(formula.variable_count);
+  for (int i = 0; i < formula.clauses.size(); i++) {
+    checker.add(formula.clauses[i]);
+  }
+  ifstream input(proof_path, ios::binary);
+  stringstream contents;
+  contents << input.rdbuf();
+  string proof = contents.str();
+  size_t position = 0;
+  while (position < proof.size()) {
+    // read the next step, as a letter and the literals ending with 0
+    bool deletion;
+    vector<int> literals;
+    if (binary) {
+      deletion = proof[position++] == 'd';
+      while (true) {
+        unsigned long long number = 0;
+        int shift = 0;
+        unsigned char byte = 128;
+        while (byte >= 128 && position < proof.size() && shift < 35) {
+          byte = proof[position++];
+          number |= (unsigned long long)(byte & 127) << shift;
+          shift += 7;
+        }
+        if (byte >= 128) {
+          return "TRUNCATED PROOF";
+        } else if (number == 0) {
+          break;
+        }
+        int variable = number >> 1;
+        literals.push_back((number & 1) ? -variable : variable);
+      }
+    } else {
+      size_t end = proof.find('\n', position);
+      if (end == string::npos) {
+        return "TRUNCATED PROOF";
+      }
+      istringstream line(proof.substr(position, end - position));
+      position = end + 1;
+      vector<string> words;
+      string word;
+      while (line >> word && word != "0") {
+        words.push_back(word);
+      }
+      if (word != "0" && words.empty()) {
+        continue; // an empty line
+      } else if (word != "0") {
+        return "TRUNCATED PROOF";
+      }
+      deletion = !words.empty() && words[0] == "d";
+      for (int i = deletion ? 1 : 0; i < words.size(); i++) {
+        literals.push_back(atoi(words[i].c_str()));
+      }
+    }
+    for (int i = 0; i < literals.size(); i++) {
+      if (literals[i] == 0 || abs(literals[i]) > formula.variable_count) {
+        return "WRONG LITERAL IN THE PROOF";
+      }
+    }
+    if (deletion) {
+      if (!checker.remove(literals)) {
+        return "PROOF DELETES A MISSING CLAUSE";
+      }
+    } else if (!checker.implied(literals)) {
+      return "PROOF ADDS A CLAUSE THAT DOES NOT FOLLOW";
+    } else if (literals.empty()) {
+      return "";
+    } else {
+      checker.add(literals);
+    }
+  }
+  return "PROOF WITHOUT THE EMPTY CLAUSE";
+}
+
+/*
+ * function to solve formulas as a batch, and check the line written for every
+ * formula
+ * Arguments : solver - the path of the solver, options - its options besides
+ * the batch, cnf_paths - the files of the formulas, formulas - the formulas,
+ * expected - the result expected for every formula, as check_run takes it
+ * Return value : the number of wrong results
+ */
+int check_batch(const string &solver, const vector<string> &options,
+                const vector<string> &cnf_paths,
+                const vector<Formula> &formulas,
+                const vector<string> &expected) {
+  string list_path = string(instance_directory) + "/batch.txt";
+  string output_path = string(instance_directory) + "/output.txt";
+  ofstream list(list_path);
+  for (int i = 0; i < cnf_paths.size(); i++) {
+    list << cnf_paths[i] << endl;
+  }
+  list.close();
+  vector<string> arguments = {solver, "--batch", list_path, "--seed",
+                              solver_seed};
+  arguments.insert(arguments.end(), options.begin(), options.end());
+  Run run;
+  if (!execute_solver(arguments, output_path, run)) {
+    printf("batch: %s\n", run.result.c_str());
+    return 1;
+  }
+  // the lines follow the order of the list
+  ifstream output(output_path);
+  int wrong_count = 0;
+  for (int i = 0; i < cnf_paths.size(); i++) {
+    string line, path, seconds;
+    getline(output, line);
+    istringstream fields(line);
+    fields >> path >> run.result >> seconds;
+    run.assignment.assign(formulas[i].variable_count, 0);
+    int literal;
+    while (run.result == "SAT" && fields >> literal && literal != 0) {
+      if (abs(literal) <= formulas[i].variable_count) {
+        run.assignment[abs(literal) - 1] = (literal > 0) ? 1 : 0;
+      }
+    }
+    string problem = (path != cnf_paths[i])
+                         ? "MISSING LINE"
+                         : check_run(formulas[i], run, expected[i]);
+    if (!problem.empty()) {
+      printf("%s in the batch: %s\n", cnf_paths[i].c_str(), problem.c_str());
+      wrong_count++;
+    }
+  }
+  return wrong_count;
+}
+
+/*
+ * function to write a formula to a file in DIMACS
+ * Arguments : formula - the formula, cnf_path - the path of the file
+ */
+void write_cnf(const Formula &formula, const string &cnf_path) {
+  FILE *cnf = fopen(cnf_path.c_str(), "w");
+  write_dimacs(formula, cnf);
+  fclose(cnf);
+}
+
+/*
+ * function to check that the memory budget applies to every formula of a
+ * batch on its own. a small formula is solved before and after a large one
+ * that uses up the budget, on one thread, so that the worker solving the
+ * second small formula kept the memory of the large one
+ * Arguments : solver - the path of the solver
+ * Return value : the number of wrong results
+ */
+int check_batch_memory(const string &solver) {
+  Formula small, large;
+  generate_random(20, 60, 3, 7, small);
+  generate_counter(14, 1000, 0, large);
+  string small_path = string(instance_directory) + "/memory-small.cnf";
+  string large_path = string(instance_directory) + "/memory-large.cnf";
+  write_cnf(small, small_path);
+  write_cnf(large, large_path);
+  string answer = reference_satisfiable(small.clauses) ? "SAT" : "UNSAT";
+  return check_batch(solver, {"--threads", "1", "--memory", "4"},
+                     {small_path, large_path, small_path},
+                     {small, large, small}, {answer, "UNKNOWN", answer});
+}
+
+/*
+ * function to write a text to a file, compressed with gzip or xz, or as it is
+ * Arguments : text - the text, path - the path of the file, compression -
+ * "gzip", "xz" or an empty string for none
+ * Return value : true, if the file was written, false, if not
+ */
+bool write_text(const string &text, const string &path,
+                const string &compression) {
+  if (compression == "gzip") {
+    gzFile file = gzopen(path.c_str(), "wb");
+    if (file == nullptr) {
+      return false;
+    }
+    bool written = gzwrite(file, text.data(), text.size()) == text.size();
+    return gzclose(file) == Z_OK && written;
+  }
+  string data = text;
+  if (compression == "xz") {
+    data.resize(lzma_stream_buffer_bound(text.size()));
+    size_t size = 0;
+    if (lzma_easy_buffer_encode(6, LZMA_CHECK_CRC64, nullptr,
+                                (const uint8_t *)text.data(), text.size(),
+                                (uint8_t *)&data[0], &size,
+                                data.size()) != LZMA_OK) {
+      return false;
+    }
+    data.resize(size);
+  }
+  ofstream file(path, ios::binary);
+  file << data;
+  return (bool)file;
+}
+
+/*
+ * function to check that the solver reads the forms of input it accepts: a
+ * formula with comments inside its clauses, one whose last clause has no
+ * terminating 0, one ended by %, and one compressed with gzip and with xz,
+ * from files and through a pipe to standard input
+ * Arguments : solver - the path of the solver
+ * Return value : the number of wrong results
+ */
+int check_inputs(const string &solver) {
+  Formula formula;
+  generate_random(30, 125, 3, 11, formula);
+  string expected = reference_satisfiable(formula.clauses) ? "SAT" : "UNSAT";
+  // the formula in DIMACS, and with a comment line inside every clause
+  ostringstream plain, commented;
+  plain << "p cnf " << formula.variable_count << " " << formula.clauses.size()
+        << "\n";
+  commented << "c a formula with comments inside its clauses\n"
+            << "p cnf " << formula.variable_count << " "
+            << formula.clauses.size() << "\n";
+  for (int i = 0; i < formula.clauses.size(); i++) {
+    for (int j = 0; j < formula.clauses[i].size(); j++) {
+      plain << formula.clauses[i][j] << " ";
+      commented << formula.clauses[i][j] << ((j == 0) ? "\nc inside\n" : " ");
+    }
+    plain << "0\n";
+    commented << "0\n";
+  }
+  string text = plain.str();
+  // the name of every file, its text, its compression, and if it is piped
+  const vector<vector<string>> inputs = {
+      {"commented.cnf", commented.str(), "", ""},
+      {"open.cnf", text.substr(0, text.size() - 2), "", ""},
+      {"percent.cnf", text + "%\n0\n", "", ""},
+      {"formula.cnf.gz", text, "gzip", ""},
+      {"formula.cnf.xz", text, "xz", ""},
+      {"piped.cnf", text, "", "pipe"},
+      {"piped.cnf.gz", text, "gzip", "pipe"},
+      {"piped.cnf.xz", text, "xz", "pipe"}};
+  int wrong_count = 0;
+  for (int i = 0; i < inputs.size(); i++) {
+    string path = string(instance_directory) + "/input-" + inputs[i][0];
+    Run run;
+    string problem = "NOT WRITTEN";
+    if (write_text(inputs[i][1], path, inputs[i][2])) {
+      run_solver(solver, {}, path, formula, run, !inputs[i][3].empty());
+      problem = check_run(formula, run, expected);
+    }
+    if (!problem.empty()) {
+      printf("input %s: %s\n", inputs[i][0].c_str(), problem.c_str());
+      wrong_count++;
+    }
+  }
+  return wrong_count;
+}
+
+/*
+ * function to solve a formula with several configurations of the solver, and
+ * check every result and, when a configuration writes a proof of
+ * unsatisfiability, the proof
+ * Arguments : solver - the path of the solver, configurations - the options
+ * of every configuration, cnf_path - the formula, formula - the formula in
+ * memory, name - the name of the formula in the messages, expected - SAT,
+ * UNSAT or ? if it is not known, in which case it is set by the first
+ * result, so that the configurations must agree
+ * Return value : the number of wrong results
+ */
+int check_formula(const string &solver,
+                  const vector<vector<string>> &configurations,
+                  const string &cnf_path, const Formula &formula,
+                  const string &name, string &expected) {
+  int wrong_count = 0;
+  for (int i = 0; i < configurations.size(); i++) {
+    const vector<string> &options = configurations[i];
+    Run run;
+    run_solver(solver, options, cnf_path, formula, run);
+    string problem = check_run(formula, run, expected);
+    vector<string>::const_iterator proof =
+        find(options.begin(), options.end(), "--proof");
+    if (problem.empty() && run.result == "UNSAT" && proof != options.end()) {
+      bool binary = find(options.begin(), options.end(), "--binary-proof") !=
+                    options.end();
+      problem = check_proof(formula, *(proof + 1), binary);
+    }
+    if (problem.empty() && expected == "?") {
+      expected = run.result;
+    } else if (!problem.empty()) {
+      string text;
+      for (int j = 0; j < options.size(); j++) {
+        text += " " + options[j];
+      }
+      printf("%s with options%s: %s\n", name.c_str(), text.c_str(),
+             problem.c_str());
+      wrong_count++;
+    }
+  }
+  return wrong_count;
+}
+
+/*
+ * function to check that the budgets stop the search with UNKNOWN, on a
+ * formula that takes far more than they allow
+ * Arguments : solver - the path of the solver
+ * Return value : the number of wrong results
+ */
+int check_budgets(const string &solver) {
+  Formula formula;
+  generate_pigeonhole(9, formula); // unsatisfiable, in seconds
+  string cnf_path = string(instance_directory) + "/budgets.cnf";
+  write_cnf(formula, cnf_path);
+  string expected = "UNKNOWN";
+  return check_formula(solver,
+                       {{"--conflicts", "1"},
+                        {"--propagations", "1"},
+                        {"--time", "0.05"}},
+                       cnf_path, formula, "pigeonhole-9", expected);
+}
+
+/*
+ * function to check that two runs with the same seed take the same search,
+ * with the same result, model and, if the build has statistics, conflicts
+ * Arguments : solver - the path of the solver
+ * Return value : the number of wrong results
+ */
+int check_determinism(const string &solver) {
+  Formula formula;
+  generate_random(200, 852, 3, 3, formula); // about 10000 conflicts
+  string cnf_path = string(instance_directory) + "/determinism.cnf";
+  write_cnf(formula, cnf_path);
+  Run first, second;
+  run_solver(solver, {}, cnf_path, formula, first);
+  run_solver(solver, {}, cnf_path, formula, second);
+  string problem = check_run(formula, first, "?");
+  if (problem.empty() &&
+      (first.result != second.result || first.assignment != second.assignment ||
+       first.conflicts != second.conflicts)) {
+    problem = "DIFFERENT RUNS WITH THE SAME SEED";
+  }
+  if (!problem.empty()) {
+    printf("determinism: %s\n", problem.c_str());
+    return 1;
+  }
+  return 0;
+}
+
+/*
+ * function to check a profile of the seeds, which must have a line with the
+ * right result for every seed, in order from the first seed, followed by
+ * the lines of the percentiles
+ * Arguments : solver - the path of the solver
+ * Return value : the number of wrong results
+ */
+int check_profile(const string &solver) {
+  const int seed_count = 4;
+  Formula formula;
+  generate_pigeonhole(7, formula); // unsatisfiable
+  string cnf_path = string(instance_directory) + "/profile.cnf";
+  string output_path = string(instance_directory) + "/output.txt";
+  write_cnf(formula, cnf_path);
+  Run run;
+  string problem;
+  if (!execute_solver({solver, cnf_path, "--profile", to_string(seed_count),
+                       "--threads", "2", "--seed", "1"},
+                      output_path, run)) {
+    problem = run.result;
+  }
+  ifstream output(output_path);
+  string line;
+  getline(output, line); // the titles
+  for (int i = 0; i < seed_count && problem.empty(); i++) {
+    long long seed = -1;
+    string result;
+    getline(output, line);
+    istringstream(line) >> seed >> result;
+    if (seed != i + 1 || result != "UNSAT") {
+      problem = "WRONG LINE " + line;
+    }
+  }
+  string titles, seconds, conflicts;
+  getline(output, titles);
+  getline(output, seconds);
+  getline(output, conflicts);
+  if (problem.empty() && (seconds.compare(0, 7, "seconds") != 0 ||
+                          conflicts.compare(0, 9, "conflicts") != 0)) {
+    problem = "NO PERCENTILES";
+  }
+  if (!problem.empty()) {
+    printf("profile: %s\n", problem.c_str());
+    return 1;
+  }
+  return 0;
+}
+
+/*
+ * function to check the results of the solver. small random formulas are
+ * solved with several configurations and checked against the reference
+ * solver. larger formulas, which take enough conflicts to reach the
+ * reductions of the learnt clauses, the garbage collection and the
+ * inprocessing, are solved with more configurations, and their proofs are
+ * checked. all the formulas are then solved once more as a batch
+ * Arguments : solver - the path of the solver, formula_count - the number of
+ * small formulas
+ * Return value : 0 if every result is right, 1 otherwise
+ */
+int run_checks(const string &solver, int formula_count) {
+  string proof_path = string(instance_directory) + "/proof.drat";
+  const vector<vector<string>> configurations = {
+      {},
+      {"--preprocess"},
+      {"--restart", "luby"},
+      {"--restart", "none"},
+      {"--threads", "2"},
+      {"--cubes", "4", "--threads", "2"},
+      {"--proof", proof_path, "--binary-proof"}};
+  const vector<vector<string>> long_configurations = {
+      {},
+      {"--preprocess"},
+      {"--learnt-memory", "1"},
+      {"--threads", "2"},
+      {"--proof", proof_path},
+      {"--proof", proof_path, "--binary-proof", "--proof-thread"}};
+  // formulas that take well over 5000 conflicts, as family, arguments and
+  // expected result
+  const vector<pair<string, vector<int>>> long_families = {
+      {"pigeonhole", {8}},
+      {"random", {200, 852, 3, 1}},
+      {"random", {200, 852, 3, 3}},
+      {"random", {200, 852, 3, 6}}};
+  vector<string> cnf_paths, expected;
+  vector<Formula> formulas;
+  int wrong_count = 0;
+  for (int seed = 0; seed < formula_count; seed++) {
+    // vary the size and the clause lengths around the threshold
+    Formula formula;
+    int variable_count = 5 + seed % 36;
+    int clause_size = 2 + seed % 3;
+    int clause_count =
+        variable_count * (clause_size == 2 ? 1 : clause_size == 3 ? 4 : 9);
+    generate_random(variable_count, clause_count + seed % 7, clause_size, seed,
+                    formula);
+    string cnf_path =
+        string(instance_directory) + "/check-" + to_string(seed) + ".cnf";
+    write_cnf(formula, cnf_path);
+    string answer = reference_satisfiable(formula.clauses) ? "SAT" : "UNSAT";
+    wrong_count += check_formula(solver, configurations, cnf_path, formula,
+                                 "formula " + to_string(seed), answer);
+    cnf_paths.push_back(cnf_path);
+    formulas.push_back(formula);
+    expected.push_back(answer);
+  }
+  for (int i = 0; i < long_families.size(); i++) {
+    Formula formula;
+    generate_family(long_families[i].first, long_families[i].second, formula);
+    string name = long_families[i].first;
+    for (int j = 0; j < long_families[i].second.size(); j++) {
+      name += "-" + to_string(long_families[i].second[j]);
+    }
+    string cnf_path = string(instance_directory) + "/" + name + ".cnf";
+    write_cnf(formula, cnf_path);
+    string answer = (long_families[i].first == "pigeonhole") ? "UNSAT" : "?";
+    wrong_count += check_formula(solver, long_configurations, cnf_path,
+                                 formula, name, answer);
+    cnf_paths.push_back(cnf_path);
+    formulas.push_back(formula);
+    expected.push_back(answer);
+  }
+  wrong_count +=
+      check_batch(solver, {"--threads", "2"}, cnf_paths, formulas, expected);
+  wrong_count += check_batch_memory(solver);
+  wrong_count += check_inputs(solver);
+  wrong_count += check_budgets(solver);
+  wrong_count += check_determinism(solver);
+  wrong_count += check_profile(solver);
+  printf("checked %d small formulas with %d configurations, %d larger "
+         "formulas with %d configurations, a batch of all of them, the "
+         "memory budget in a batch, the forms of input, the budgets, the "
+         "seeds and a profile, %d wrong results\n",
+         formula_count, (int)configurations.size(), (int)long_families.size(),
+         (int)long_configurations.size(), wrong_count);
+  return (wrong_count > 0) ? 1 : 0;
+}
+
+/*
+ * the main() function
+ */
+int main(int argc, char *argv[]) {
+  mkdir(instance_directory, 0755);
+  // a solver that stops reading its input must not stop the runner
+  signal(SIGPIPE, SIG_IGN);
+  if (argc == 4 && string(argv[1]) == "--check") {
+    statistics_supported = solver_has_statistics(argv[2]);
+    return run_checks(argv[2], atoi(argv[3]));
+  } else if (argc == 5 && string(argv[1]) == "--write-baseline") {
+    statistics_supported = solver_has_statistics(argv[2]);
+    return run_benchmarks(argv[2], argv[3], argv[4], true);
+  } else if (argc == 4) {
+    statistics_supported = solver_has_statistics(argv[1]);
+    return run_benchmarks(argv[1], argv[2], argv[3], false);
+  }
+  cerr << "Usage: " << argv[0] << " solver suite baseline" << endl
+       << "       " << argv[0] << " --write-baseline solver suite baseline"
+       << endl
+       << "       " << argv[0] << " --check solver formula_count" << endl;
+  return 1;
+}
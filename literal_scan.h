@@ -0,0 +1,123 @@
+/*
+ * Functions to scan a block of packed literals for the first one that is true,
+ * or the first one that is not false, reading the values kept per literal. on
+ * x86 processors that support AVX2, the values of eight literals are gathered
+ * at once, and a scalar loop is used everywhere else
+ */
+
+#ifndef LITERAL_SCAN_H
+#define LITERAL_SCAN_H
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LITERAL_SCAN_AVX2
+#include <immintrin.h>
+#endif
+
+/*
+ * number of bytes that must follow the values of the literals, since the
+ * vectorized scan reads four bytes at the value of every literal
+ */
+const int literal_value_padding = 3;
+
+/*
+ * number of literals at the start of a block that are always scanned one by
+ * one. the literal looked for is often among the first few, which a single
+ * load finds faster than a gather
+ */
+const int scalar_scan_prefix = 8;
+
+/*
+ * number of literals from which a block is scanned with AVX2, below which the
+ * gathers do not pay off
+ */
+const int vector_scan_minimum = 16;
+
+/*
+ * function to scan a block of literals one by one
+ * Arguments : values - the value of every literal, 1 if true, 0 if false and
+ * -1 if unassigned, literals - the block, size - the number of literals in
+ * it, find_true - true to look for a true literal, false to look for one
+ * that is not false
+ * Return value : the index of the first such literal, or size if there is none
+ */
+inline int scan_literals_scalar(const int8_t *values, const int *literals,
+                                int size, bool find_true) {
+  for (int i = 0; i < size; i++) {
+    int value = values[literals[i]];
+    if (find_true ? value == 1 : value != 0) {
+      return i;
+    }
+  }
+  return size;
+}
+
+#ifdef LITERAL_SCAN_AVX2
+/*
+ * function to scan a block of literals eight at a time with AVX2. the values
+ * array must be followed by literal_value_padding readable bytes
+ * Arguments : as for scan_literals_scalar
+ * Return value : the index of the first such literal, or size if there is none
+ */
+__attribute__((target("avx2"))) inline int
+scan_literals_avx2(const int8_t *values, const int *literals, int size,
+                   bool find_true) {
+  const __m256i looked_for = _mm256_set1_epi32(find_true ? 1 : 0);
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m256i indices =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(literals + i));
+    // gather the four bytes starting at every value, and sign extend the
+    // first of them
+    __m256i words = _mm256_i32gather_epi32(
+        reinterpret_cast<const int *>(values), indices, 1);
+    __m256i lane_values = _mm256_srai_epi32(_mm256_slli_epi32(words, 24), 24);
+    int equal_mask = _mm256_movemask_ps(
+        _mm256_castsi256_ps(_mm256_cmpeq_epi32(lane_values, looked_for)));
+    // a literal that is not false is one that does not equal 0
+    int found_mask = find_true ? equal_mask : (~equal_mask & 0xff);
+    if (found_mask != 0) {
+      return i + __builtin_ctz(found_mask);
+    }
+  }
+  return i + scan_literals_scalar(values, literals + i, size - i, find_true);
+}
+
+/*
+ * function to check once if the processor supports AVX2
+ * Return value : true, if yes, false, if no
+ */
+inline bool avx2_supported() {
+  static const bool supported =
+      (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+  return supported;
+}
+#endif
+
+/*
+ * function to scan a block of literals, with AVX2 after the first
+ * scalar_scan_prefix literals if the block is long enough and the processor
+ * supports it
+ * Arguments : as for scan_literals_scalar
+ * Return value : the index of the first such literal, or size if there is none
+ */
+inline int scan_literals(const int8_t *values, const int *literals, int size,
+                         bool find_true) {
+  int prefix = std::min(size, scalar_scan_prefix);
+  int found = scan_literals_scalar(values, literals, prefix, find_true);
+  if (found < prefix || prefix == size) {
+    return found;
+  }
+#ifdef LITERAL_SCAN_AVX2
+  if (size >= vector_scan_minimum && avx2_supported()) {
+    return prefix + scan_literals_avx2(values, literals + prefix,
+                                       size - prefix, find_true);
+  }
+#endif
+  return prefix + scan_literals_scalar(values, literals + prefix,
+                                       size - prefix, find_true);
+}
+
+#endif
@@ -0,0 +1,224 @@
+/*
+ * Command line interface of the SAT solver based on Conflict Driven Clause
+ * Learning
+ */
+
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <vector>
+
+#include "solver.h"
+
+using namespace std;
+
+SATSolverCDCL *interrupted_solver = nullptr; // the solver stopped by signals
+
+/*
+ * function to handle SIGINT and SIGTERM by interrupting the solver, so that it
+ * reports UNKNOWN and its statistics. a second signal ends the program
+ * Arguments : signal_number - the signal received
+ */
+void handle_signal(int signal_number) {
+  interrupted_solver->interrupt();
+  signal(signal_number, SIG_DFL);
+}
+
+/*
+ * function to get the files of a batch, which are either the regular files of
+ * a directory, in the order of their names, or those listed in a file, one
+ * path per line, in the order of the list
+ * Arguments : path - the path of the directory or the list, paths - to store
+ * the paths of the files
+ * Return value : true, if the files could be found, false, if not
+ */
+bool read_batch_paths(const char *path, vector<string> &paths) {
+  struct stat path_status;
+  if (stat(path, &path_status) != 0) {
+    return false;
+  }
+  if (!S_ISDIR(path_status.st_mode)) {
+    ifstream list(path);
+    string line;
+    while (getline(list, line)) {
+      if (!line.empty()) {
+        paths.push_back(line);
+      }
+    }
+    return !list.bad();
+  }
+  DIR *directory = opendir(path);
+  if (directory == nullptr) {
+    return false;
+  }
+  string prefix = path;
+  if (prefix.back() != '/') {
+    prefix += '/';
+  }
+  while (dirent *entry = readdir(directory)) {
+    string file_path = prefix + entry->d_name;
+    struct stat file_status;
+    if (stat(file_path.c_str(), &file_status) == 0 &&
+        S_ISREG(file_status.st_mode)) {
+      paths.push_back(file_path);
+    }
+  }
+  closedir(directory);
+  sort(paths.begin(), paths.end());
+  return true;
+}
+
+/*
+ * the main() function
+ */
+int main(int argc, char *argv[]) {
+  SATSolverCDCL solver;
+  const char *input_path = nullptr; // read from standard input by default
+  int thread_count = 0;             // number of worker threads, 0 if not set
+  int cube_count = 0; // number of cubes for cube and conquer, 0 not to use it
+  bool statistics_enabled = false;       // if statistics are reported
+  const char *statistics_path = nullptr; // file for the final statistics
+  const char *proof_path = nullptr;      // file for the DRAT proof, if any
+  bool binary_proof = false;             // if the proof is in binary DRAT
+  bool proof_thread = false; // if the proof is written by a background thread
+  const char *batch_path = nullptr; // directory or list of files to solve
+  bool completion_order = false;    // if batch lines follow the completion
+  int profile_count = 0; // number of seeds to profile, 0 not to profile
+  // read the options
+  for (int i = 1; i < argc; i++) {
+    string option = argv[i];
+    if (option.empty() || option[0] != '-') // the input file
+    {
+      input_path = argv[i];
+      continue;
+    }
+    if (option == "--learnt-memory" && i + 1 < argc) {
+      // budget for learnt clauses in megabytes
+      solver.set_learnt_memory_budget(atoll(argv[++i]) * 1024 * 1024);
+    } else if (option == "--threads" && i + 1 < argc) {
+      thread_count = max(1, atoi(argv[++i]));
+    } else if (option == "--cubes" && i + 1 < argc) {
+      cube_count = max(0, atoi(argv[++i]));
+    } else if (option == "--stats") {
+      statistics_enabled = true;
+    } else if (option == "--stats-json" && i + 1 < argc) {
+      statistics_enabled = true;
+      statistics_path = argv[++i];
+    } else if (option == "--proof" && i + 1 < argc) {
+      proof_path = argv[++i];
+    } else if (option == "--binary-proof") {
+      binary_proof = true;
+    } else if (option == "--proof-thread") {
+      proof_thread = true;
+    } else if (option == "--conflicts" && i + 1 < argc) {
+      solver.set_conflict_budget(max(0LL, atoll(argv[++i])));
+    } else if (option == "--propagations" && i + 1 < argc) {
+      solver.set_propagation_budget(max(0LL, atoll(argv[++i])));
+    } else if (option == "--time" && i + 1 < argc) {
+      solver.set_time_budget(max(0.0, atof(argv[++i])));
+    } else if (option == "--memory" && i + 1 < argc) {
+      // budget for all the clauses in megabytes
+      solver.set_memory_budget(max(0LL, atoll(argv[++i])) * 1024 * 1024);
+    } else if (option == "--batch" && i + 1 < argc) {
+      batch_path = argv[++i];
+    } else if (option == "--completion-order") {
+      completion_order = true;
+    } else if (option == "--seed" && i + 1 < argc) {
+      solver.set_seed(strtoul(argv[++i], nullptr, 10));
+    } else if (option == "--profile" && i + 1 < argc) {
+      profile_count = max(0, atoi(argv[++i]));
+    } else if (option == "--random-decisions" && i + 1 < argc) {
+      solver.set_random_decision_frequency(
+          min(1.0, max(0.0, atof(argv[++i]))));
+    } else if (option == "--decay" && i + 1 < argc) {
+      double decay = atof(argv[++i]);
+      if (decay <= 0 || decay > 1) {
+        cerr << "The decay must be above 0 and at most 1" << endl;
+        return 1;
+      }
+      solver.set_activity_decay(decay);
+    } else if (option == "--preprocess") {
+      solver.set_preprocessing(true);
+    } else if (option == "--restart" && i + 1 < argc) {
+      string policy = argv[++i];
+      if (policy == "luby") {
+        solver.set_restart_policy(RestartPolicy::rp_luby);
+      } else if (policy == "glucose") {
+        solver.set_restart_policy(RestartPolicy::rp_glucose);
+      } else if (policy == "none") {
+        solver.set_restart_policy(RestartPolicy::rp_none);
+      } else {
+        cerr << "Unknown restart policy: " << policy << endl;
+        return 1;
+      }
+    } else {
+      cerr << "Unknown option: " << option << endl;
+      return 1;
+    }
+  }
+  if (batch_path != nullptr &&
+      (cube_count > 0 || proof_path != nullptr || statistics_enabled)) {
+    cerr << "A batch cannot be combined with cubes, proofs or statistics"
+         << endl;
+    return 1;
+  }
+  if (profile_count > 0 &&
+      (batch_path != nullptr || cube_count > 0 || proof_path != nullptr ||
+       statistics_enabled)) {
+    cerr << "Profiling cannot be combined with a batch, cubes, proofs or "
+            "statistics"
+         << endl;
+    return 1;
+  }
+  if (thread_count == 0) {
+    // the runs of a profile fill the machine, and the rest use one thread
+    thread_count =
+        (profile_count > 0) ? max(1U, thread::hardware_concurrency()) : 1;
+  }
+  if (!solver.set_statistics(statistics_enabled, statistics_path)) {
+    cerr << "The solver was built without statistics" << endl;
+    return 1;
+  }
+  if (proof_path != nullptr) {
+    if (thread_count > 1 || cube_count > 0) {
+      cerr << "A proof can only be written by a single thread" << endl;
+      return 1;
+    }
+    if (!solver.set_proof(proof_path, binary_proof, proof_thread)) {
+      cerr << "Could not open " << proof_path << endl;
+      return 1;
+    }
+  }
+  // stop the search on a signal, while still showing the result
+  interrupted_solver = &solver;
+  signal(SIGINT, handle_signal);
+  signal(SIGTERM, handle_signal);
+  if (batch_path != nullptr) {
+    vector<string> paths;
+    if (!read_batch_paths(batch_path, paths)) {
+      cerr << "Could not read the batch " << batch_path << endl;
+      return 1;
+    }
+    solver.solve_batch(paths, thread_count, completion_order);
+    return 0;
+  }
+  if (!solver.initialize(input_path)) {
+    return 1;
+  }
+  if (profile_count > 0) {
+    solver.profile_seeds(profile_count, thread_count);
+  } else if (cube_count > 0) {
+    solver.solve_cubes(cube_count, thread_count);
+  } else if (thread_count > 1) {
+    solver.solve_portfolio(thread_count);
+  } else {
+    solver.solve();
+  }
+  return 0;
+}
@@ -4,574 +4,4066 @@
  */
 
 #include <algorithm>
-#include <cmath>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <iomanip>
 #include <iostream>
+#include <lzma.h>
+#include <memory>
+#include <mutex>
 #include <random>
+#include <sstream>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
 #include <vector>
+#include <zlib.h>
+
+#include "literal_scan.h"
+#include "solver.h"
 
 using namespace std;
 
 /*
- * enum to store exit states for certain functions in the solver
+ * class to add the time spent in a scope to a timer, if timing is enabled
  */
-enum RetVal {
-  r_satisfied,   // the formula has been satisfied
-  r_unsatisfied, // the formula has been unsatisfied
-  r_normal       // the formula is unresolved so far
+class ScopedTimer {
+private:
+  double &total;                           // the timer to add to
+  bool enabled;                            // if the time is measured
+  chrono::steady_clock::time_point start;  // the time the scope was entered
+
+public:
+  ScopedTimer(double &timer, bool timing_enabled)
+      : total(timer), enabled(timing_enabled) {
+    if (enabled) {
+      start = chrono::steady_clock::now();
+    }
+  } // constructor
+  ~ScopedTimer() {
+    if (enabled) {
+      total += chrono::duration<double>(chrono::steady_clock::now() - start)
+                   .count();
+    }
+  } // destructor
 };
 
 /*
- * class containing the member variables and functions of the CDCL SAT solver
+ * macros to update the statistics only when SOLVER_STATISTICS is defined, so
+ * that they cost nothing otherwise. STATISTIC runs a statement updating a
+ * counter, and TIME_SCOPE adds the time until the end of the enclosing scope
+ * to a timer
  */
-class SATSolverCDCL {
-private:
-  /*
-   * a vector to store the state of each variable, where the assignment is as
-   * 1 - assigned true
-   * 0 - assigned false
-   * -1 - unassigned
-   */
-  vector<int> literals;
+#ifdef SOLVER_STATISTICS
+#define STATISTIC(statement) statement
+#define TIME_SCOPE(timer) ScopedTimer scoped_timer(timer, statistics_enabled)
+#else
+#define STATISTIC(statement)
+#define TIME_SCOPE(timer)
+#endif
 
-  /*
-   * a 2D vector that stores a list of literals for every clause
-   * for the one indexed variable l, l is stored when it is present with
-   * positive polarity and -l is stored when it is present with negative
-   * polarity
-   */
-  vector<vector<int>> literal_list_per_clause;
+const int progress_interval = 10000; // conflicts between progress lines
 
-  /*
-   * vector that stores the total number of occurrences of the variable in the
-   * formula this is updated when clauses are learnt this is used for choosing
-   * the next variable to be assigned
-   */
-  vector<int> literal_frequency;
+/*
+ * functions for the packed form of the literals used inside the solver. for
+ * the one indexed variable v, the literal v is packed as 2 * (v - 1) and -v as
+ * 2 * (v - 1) + 1, so that a literal indexes the vectors kept per literal
+ * directly, its variable is found by a shift and its negation by flipping the
+ * lowest bit, without branching on the sign. the one indexed signed form is
+ * only used at the interface of the solver
+ */
+constexpr int pack_literal(int literal) {
+  return (literal > 0) ? 2 * (literal - 1) : 2 * (-literal - 1) + 1;
+}
+constexpr int unpack_literal(int literal) {
+  return (literal & 1) ? -(literal >> 1) - 1 : (literal >> 1) + 1;
+}
+constexpr int literal_to_variable_index(int literal) { return literal >> 1; }
+constexpr int negate_literal(int literal) { return literal ^ 1; }
+constexpr bool literal_is_negative(int literal) { return literal & 1; }
+constexpr int variable_to_literal(int variable, bool negative) {
+  return 2 * variable + negative;
+}
 
-  /*
-   * vector that stores the difference in the number of positive and negative
-   * occurrences of the variable in the formula. this is updated when clauses
-   * are learnt
-   */
-  vector<int> literal_polarity;
+/*
+ * the largest variable accepted from outside, so that the packed literals and
+ * the sizes of the vectors kept per literal fit in an int, and a function to
+ * check that a literal in the one indexed signed form is not 0 and is within
+ * it
+ */
+const int max_variable = INT_MAX / 4;
+constexpr bool literal_in_range(int literal) {
+  return literal != 0 && literal >= -max_variable && literal <= max_variable;
+}
 
-  /*
-   * vector to store backup of the frequencies, as the original will be set to
-   * -1 when the variable is assigned. this is use to reset the value back to
-   * the original if and when the variable is later unassigned
-   */
-  vector<int> original_literal_frequency;
-  int literal_count;    // number of variables in the formula
-  int clause_count;     // number of clauses in the formula
-  int kappa_antecedent; // antecedent of the conflict, kappa
+/*
+ * function to give the antecedent of a literal implied through the implication
+ * lists, which is -2 - l for the other literal l of the binary clause. such an
+ * antecedent gives the false literal that implied the variable without the
+ * clause being read, while -1 still stands for none and references to clauses
+ * are not negative. the same function turns the antecedent back into l
+ */
+constexpr int binary_antecedent(int literal) { return -2 - literal; }
+
+/*
+ * function to write a packed literal in the one indexed signed form of DIMACS,
+ * without going through a stream
+ * Arguments : output - where to write, with room for at least 12 characters,
+ * literal - the packed literal
+ * Return value : the position after the last character written
+ */
+char *write_dimacs_literal(char *output, int literal) {
+  // write the digits backwards into a small buffer, then copy them
+  char digits[12];
+  int digit_count = 0;
+  unsigned int value = literal_to_variable_index(literal) + 1;
+  do {
+    digits[digit_count++] = '0' + value % 10;
+    value /= 10;
+  } while (value > 0);
+  if (literal_is_negative(literal)) {
+    *output++ = '-';
+  }
+  while (digit_count > 0) {
+    *output++ = digits[--digit_count];
+  }
+  return output;
+}
 
+/*
+ * class to read the input formula as a stream of characters. a regular file is
+ * memory mapped, while standard input and pipes are read through a buffer.
+ * gzip and xz compressed input is recognized by its magic bytes and is
+ * decompressed on the fly
+ */
+class InputReader {
+private:
   /*
-   * vector to store the decision level of each variable
-   * when not yet assigned, it contains -1
+   * enum to store the compression formats of the input
    */
-  vector<int> literal_decision_level;
+  enum Compression {
+    c_none, // plain text
+    c_gzip, // gzip compressed
+    c_xz    // xz compressed
+  };
+
+  int file_descriptor; // descriptor of the input, -1 if not open
+  int compression;     // compression format of the input
+  char *mapped_data;   // contents of a memory mapped file, or nullptr
+  size_t mapped_size;  // size of the memory mapped file
 
   /*
-   * vector to store the antecedent of each variable
-   * NIL is represented by -1
+   * buffer of raw bytes read from the input, of which those from raw_start to
+   * raw_end are yet to be used
    */
-  vector<int> literal_antecedent;
-  int assigned_literal_count; // the number of variables assigned so far
-  bool already_unsatisfied;   // if the formula contains any empty clause
-                              // originally
-  int pick_counter; // the number of times we have chosen a variable freely
-                    // based on frequency
-  random_device random_generator;
-  mt19937 generator;
-
-  int unit_propagate(int); // to perform unit propagation
-  // to assign a literal with given value, antecedent and decision level
-  void assign_literal(int, int, int);
-  void unassign_literal(int); // to unassign a given literal
-                              // to convert the one indexed literal with sign to
-                              // zero indexed without sign
-  int literal_to_variable_index(int);
-  int conflict_analysis_and_backtrack(
-      int); // to perform conflict analysis and backtrack
-  vector<int> &resolve(vector<int> &,
-                       int);     // to resolve two clauses and get the result
-  int pick_branching_variable(); // to pick the next free assignment
-  bool all_variables_assigned(); // to check if all variables have already been
-                                 // assigned
-  void show_result(int);         // to display the result of the solver
+  vector<unsigned char> raw_buffer;
+  size_t raw_start;
+  size_t raw_end;
+  bool raw_exhausted; // if the end of the input has been read
+
+  vector<char> decompressed_buffer; // buffer of decompressed characters
+  const char *position;             // next character to be returned
+  const char *end;                  // end of the characters available
+  long long characters_read;        // number of characters made available
+  z_stream gzip_stream;             // state of the gzip decompressor
+  lzma_stream xz_stream;            // state of the xz decompressor
+
+  bool fill_raw_buffer(); // to read more raw bytes from the input
+  bool refill();          // to make more characters available
 
 public:
-  SATSolverCDCL() : generator(random_generator()) {} // constructor
-  void initialize();                                 // to initialize the solver
-  int CDCL(); // to perform the CDCL algorithm and return the appropriate result
-              // state
-  void solve(); // to solve the problem and display the result
+  InputReader();  // constructor
+  ~InputReader(); // destructor
+  bool open(const char *); // to open a file, or standard input for nullptr
+  /*
+   * function to get the next character without consuming it
+   * Return value : the character, or EOF at the end of the input
+   */
+  int peek() {
+    if (position == end && !refill()) {
+      return EOF;
+    }
+    return *position;
+  }
+  void advance() { position++; } // to consume the character seen by peek()
+  void skip_whitespace();        // to consume spaces, tabs and newlines
+  void skip_line();              // to consume the rest of the current line
+  bool read_word(string &);      // to read a sequence of non-space characters
+  bool read_integer(int &);      // to read a signed decimal integer
+  long long bytes_read() { return characters_read; } // to get the input size
 };
 
 /*
- * function to initialize the solver
+ * the constructor, which leaves the reader without any input
  */
-void SATSolverCDCL::initialize() {
-  char c;   // store first character
-  string s; // dummy string
+InputReader::InputReader()
+    : file_descriptor(-1), compression(Compression::c_none),
+      mapped_data(nullptr), mapped_size(0), raw_start(0), raw_end(0),
+      raw_exhausted(false), position(nullptr), end(nullptr),
+      characters_read(0) {}
 
-  while (true) {
-    cin >> c;
-    if (c == 'c') // if comment
-    {
-      getline(cin, s); // ignore
-    } else             // else, if would be a p
-    {
-      cin >> s; // this would be cnf
-      break;
-    }
+/*
+ * the destructor, which releases the input and the decompressor
+ */
+InputReader::~InputReader() {
+  if (compression == Compression::c_gzip) {
+    inflateEnd(&gzip_stream);
+  } else if (compression == Compression::c_xz) {
+    lzma_end(&xz_stream);
   }
-  cin >> literal_count;
-  cin >> clause_count;
-  assigned_literal_count = 0; // no literals assigned so far
-  // set the default values
-  kappa_antecedent = -1;
-  pick_counter = 0;
-  already_unsatisfied = false;
-  // set the vectors to their appropriate sizes and initial values
-  literals.clear();
-  literals.resize(literal_count, -1);
-  literal_frequency.clear();
-  literal_frequency.resize(literal_count, 0);
-  literal_polarity.clear();
-  literal_polarity.resize(literal_count, 0);
-  literal_list_per_clause.clear();
-  literal_list_per_clause.resize(clause_count);
-  literal_antecedent.clear();
-  literal_antecedent.resize(literal_count, -1);
-  literal_decision_level.clear();
-  literal_decision_level.resize(literal_count, -1);
-
-  int literal;                     // store the incoming literal value
-  int literal_count_in_clause = 0; // number of literals in the incoming clause
-  // iterate over the clauses
-  for (int i = 0; i < clause_count; i++) {
-    literal_count_in_clause = 0;
-    while (true) // while the ith clause gets more literals
-    {
-      cin >> literal;
-      if (literal > 0) // if the variable has positive polarity
-      {
-        literal_list_per_clause[i].push_back(literal); // store it
-        // increment frequency and polarity of the literal
-        literal_frequency[literal - 1]++;
-        literal_polarity[literal - 1]++;
-      } else if (literal < 0) // if the variable has negative polarity
-      {
-        literal_list_per_clause[i].push_back(literal); // store it
-        // increment frequency and decrement polarity of the literal
-        literal_frequency[-1 - literal]++;
-        literal_polarity[-1 - literal]--;
-      } else {
-        if (literal_count_in_clause == 0) // if any clause is empty, we can stop
-        {
-          already_unsatisfied = true;
-        }
-        break; // read 0, so move to next clause
-      }
-      literal_count_in_clause++;
-    }
+  if (mapped_data != nullptr) {
+    munmap(mapped_data, mapped_size);
+  }
+  if (file_descriptor > 0) {
+    close(file_descriptor);
   }
-  original_literal_frequency =
-      literal_frequency; // backup for restoring when backtracking
 }
 
 /*
- * function to implement the Conflict Driven Clause Learning algorithm
- * Return value : the return status, which is
- *                RetVal::r_satisfied if the formula is satisfiable
- *                RetVal::r_unsatisfied if the formula is not satisfiable
+ * function to open the input. an uncompressed regular file is memory mapped
+ * as a whole, anything else is read through the buffers
+ * Arguments : path - the path of the file, or nullptr for standard input
+ * Return value : true, if the input could be opened, false, if not
  */
-int SATSolverCDCL::CDCL() {
-  int decision_level = 0;  // initial decision level
-  if (already_unsatisfied) // if we had found an empty clause, we know that it
-                           // is unsatisfiable
-  {
-    return RetVal::r_unsatisfied;
-  }
-  // initial unit propagation to find existing top level conflicts
-  int unit_propagate_result = unit_propagate(decision_level);
-  if (unit_propagate_result == RetVal::r_unsatisfied) {
-    return unit_propagate_result;
+bool InputReader::open(const char *path) {
+  file_descriptor = (path == nullptr) ? 0 : ::open(path, O_RDONLY);
+  if (file_descriptor < 0) {
+    return false;
   }
-  while (!all_variables_assigned()) {
-    int picked_variable = pick_branching_variable(); // pick the next free
-                                                     // variable with assignment
-    decision_level++; // increment the current decision level
-    // assign the variable at the current decision level with no antecedent
-    assign_literal(picked_variable, decision_level, -1);
-    /*
-     * unit propagate and backtrack repeatedly till no conflicts are left or
-     * we found that the formula is unsatisfiable
-     */
-    while (true) {
-      unit_propagate_result = unit_propagate(decision_level);
-      if (unit_propagate_result == RetVal::r_unsatisfied) {
-        // if the conflict was at the top level, the formula is unsatisfiable
-        if (decision_level == 0) {
-          return unit_propagate_result;
-        }
-        /*
-         * if not, perform the conflict analysis, learn clauses, and backtrack
-         * to a previous decision level
-         */
-        decision_level = conflict_analysis_and_backtrack(decision_level);
-      } else // if unit propagation gave no conflicts, continue choosing another
-             // free assignment
-      {
-        break;
+  const unsigned char gzip_magic[] = {0x1f, 0x8b};
+  const unsigned char xz_magic[] = {0xfd, '7', 'z', 'X', 'Z', 0x00};
+  struct stat file_status;
+  if (fstat(file_descriptor, &file_status) == 0 &&
+      S_ISREG(file_status.st_mode) && file_status.st_size > 0) {
+    unsigned char magic[6] = {0};
+    ssize_t magic_size = pread(file_descriptor, magic, sizeof(magic), 0);
+    bool compressed =
+        (magic_size >= 2 && memcmp(magic, gzip_magic, 2) == 0) ||
+        (magic_size >= 6 && memcmp(magic, xz_magic, 6) == 0);
+    if (!compressed) {
+      void *data = mmap(nullptr, file_status.st_size, PROT_READ, MAP_PRIVATE,
+                        file_descriptor, 0);
+      if (data != MAP_FAILED) {
+        madvise(data, file_status.st_size, MADV_SEQUENTIAL);
+        mapped_data = static_cast<char *>(data);
+        mapped_size = file_status.st_size;
+        position = mapped_data;
+        end = mapped_data + mapped_size;
+        characters_read = mapped_size;
+        return true;
       }
     }
   }
-  // if we reached here, all variables were successfully assigned, and the
-  // formula is satisfiable
-  return RetVal::r_satisfied;
+  // read enough of the input to recognize the compression format
+  raw_buffer.resize(1 << 20);
+  while (raw_end < sizeof(xz_magic) && fill_raw_buffer()) {
+  }
+  if (raw_end >= 2 && memcmp(&raw_buffer[0], gzip_magic, 2) == 0) {
+    compression = Compression::c_gzip;
+    memset(&gzip_stream, 0, sizeof(gzip_stream));
+    // a window size offset by 16 accepts only the gzip format
+    if (inflateInit2(&gzip_stream, 16 + MAX_WBITS) != Z_OK) {
+      compression = Compression::c_none;
+      return false;
+    }
+  } else if (raw_end >= 6 && memcmp(&raw_buffer[0], xz_magic, 6) == 0) {
+    compression = Compression::c_xz;
+    xz_stream = LZMA_STREAM_INIT;
+    if (lzma_stream_decoder(&xz_stream, UINT64_MAX, LZMA_CONCATENATED) !=
+        LZMA_OK) {
+      compression = Compression::c_none;
+      return false;
+    }
+  }
+  if (compression != Compression::c_none) {
+    decompressed_buffer.resize(1 << 20);
+  }
+  return true;
 }
 
 /*
- * function to perform unit propagation on the formula
- * Arguments : decision_level - the current decision level at which unit
- * propagation is taking place Return value : Return state denoting the status,
- * where RetVal::r_normal - unit propagation ended successfully with no
- * conflicts RetVal::r_unsatisfied - unit propagation found a
- * conflict
+ * function to append more raw bytes from the input to the raw buffer, moving
+ * the unused bytes to its start when it is full
+ * Return value : true, if any bytes were read, false, at the end of the input
  */
-int SATSolverCDCL::unit_propagate(int decision_level) {
-  bool unit_clause_found = false; // if a unit clause has been found
-  int false_count = 0;            // number of false literals in the clause
-  int unset_count = 0;            // number of unset literals in the clause
-  int literal_index;
-  bool satisfied_flag =
-      false; // if the clause is satisfied due to the presence of a true literal
-  int last_unset_literal = -1; // index of an unset literal
+bool InputReader::fill_raw_buffer() {
+  if (raw_exhausted) {
+    return false;
+  }
+  if (raw_end == raw_buffer.size()) {
+    memmove(&raw_buffer[0], &raw_buffer[raw_start], raw_end - raw_start);
+    raw_end -= raw_start;
+    raw_start = 0;
+  }
+  ssize_t count;
   do {
-    unit_clause_found = false;
-    // iterate over all clauses if no unit clause has been found so far
-    for (int i = 0; i < literal_list_per_clause.size() && !unit_clause_found;
-         i++) {
-      false_count = 0;
-      unset_count = 0;
-      satisfied_flag = false;
-      // iterate over all literals
-      for (int j = 0; j < literal_list_per_clause[i].size(); j++) {
-        // get the vector index of the literal
-        literal_index =
-            literal_to_variable_index(literal_list_per_clause[i][j]);
-        if (literals[literal_index] == -1) // if unassigned
-        {
-          unset_count++;
-          last_unset_literal = j; // store the index, may be needed later
-        } else if ((literals[literal_index] == 0 &&
-                    literal_list_per_clause[i][j] > 0) ||
-                   (literals[literal_index] == 1 &&
-                    literal_list_per_clause[i][j] <
-                        0)) // if false in the clause
-        {
-          false_count++;
-        } else // if true in the clause, so the clause is satisfied
-        {
-          satisfied_flag = true;
-          break;
-        }
+    count = read(file_descriptor, &raw_buffer[raw_end],
+                 raw_buffer.size() - raw_end);
+  } while (count < 0 && errno == EINTR);
+  if (count <= 0) {
+    raw_exhausted = true;
+    return false;
+  }
+  raw_end += count;
+  return true;
+}
+
+/*
+ * function to make more characters available once all the previous ones have
+ * been consumed
+ * Return value : true, if any characters are available, false, at the end of
+ * the input
+ */
+bool InputReader::refill() {
+  if (mapped_data != nullptr) {
+    return false; // the whole file was available from the start
+  }
+  if (compression == Compression::c_none) {
+    // hand out the raw bytes themselves
+    if (raw_start == raw_end) {
+      raw_start = raw_end = 0;
+      if (!fill_raw_buffer()) {
+        return false;
       }
-      if (satisfied_flag) // if the clause is satisfied, move to the next
-      {
-        continue;
+    }
+    position = reinterpret_cast<const char *>(&raw_buffer[raw_start]);
+    end = reinterpret_cast<const char *>(&raw_buffer[raw_end]);
+    characters_read += raw_end - raw_start;
+    raw_start = raw_end;
+    return true;
+  }
+  char *output = &decompressed_buffer[0];
+  size_t produced = 0;
+  while (produced == 0) {
+    if (raw_start == raw_end) {
+      raw_start = raw_end = 0;
+      fill_raw_buffer();
+    }
+    size_t available = raw_end - raw_start;
+    if (compression == Compression::c_gzip) {
+      if (available == 0) {
+        return false; // the compressed input ended
       }
-      // if exactly one literal is unset, this clause is unit
-      if (unset_count == 1) {
-        // assign the unset literal at this decision level and this clause i as
-        // the antecedent
-        assign_literal(literal_list_per_clause[i][last_unset_literal],
-                       decision_level, i);
-        unit_clause_found =
-            true; // we have found a unit clause, so restart iteratin
-        break;
+      gzip_stream.next_in = &raw_buffer[raw_start];
+      gzip_stream.avail_in = available;
+      gzip_stream.next_out = reinterpret_cast<Bytef *>(output);
+      gzip_stream.avail_out = decompressed_buffer.size();
+      int status = inflate(&gzip_stream, Z_NO_FLUSH);
+      raw_start = raw_end - gzip_stream.avail_in;
+      produced = decompressed_buffer.size() - gzip_stream.avail_out;
+      if (status == Z_STREAM_END) {
+        inflateReset(&gzip_stream); // another gzip member may follow
+      } else if (status != Z_OK && status != Z_BUF_ERROR) {
+        return false; // corrupt input
       }
-      // if the clause is unsatisfied
-      else if (false_count == literal_list_per_clause[i].size()) {
-        // unsatisfied clause
-        kappa_antecedent = i; // set the antecedent of kappa to this clause
-        return RetVal::r_unsatisfied; // return a conflict status
+    } else {
+      xz_stream.next_in = &raw_buffer[raw_start];
+      xz_stream.avail_in = available;
+      xz_stream.next_out = reinterpret_cast<uint8_t *>(output);
+      xz_stream.avail_out = decompressed_buffer.size();
+      lzma_ret status =
+          lzma_code(&xz_stream, raw_exhausted ? LZMA_FINISH : LZMA_RUN);
+      raw_start = raw_end - xz_stream.avail_in;
+      produced = decompressed_buffer.size() - xz_stream.avail_out;
+      if (status != LZMA_OK && produced == 0) {
+        return false; // the stream ended or is corrupt
       }
     }
-  } while (unit_clause_found); // if a unit clause was found, we restart
-                               // iterating over the clauses
-  kappa_antecedent = -1;
-  return RetVal::r_normal; // return normally
+  }
+  position = output;
+  end = output + produced;
+  characters_read += produced;
+  return true;
 }
 
 /*
- * function to assign a value, decision level, and antecedent to a variable
- * Arguments : variable - the one indexed signed form of the variable, where the
- * sign tells the direction of assignment decision_level - the decision level to
- * assign at antecedent - the antecedent of the assignment
+ * function to consume spaces, tabs and newlines
  */
-void SATSolverCDCL::assign_literal(int variable, int decision_level,
-                                   int antecedent) {
-  int literal = literal_to_variable_index(variable); // get the index
-  int value = (variable > 0) ? 1 : 0; // choose the assignment based on sign
-  literals[literal] = value;          // assign
-  literal_decision_level[literal] = decision_level; // set decision level
-  literal_antecedent[literal] = antecedent;         // set antecedent
-  literal_frequency[literal] =
-      -1; // unset frequency so this is not chosen for assignment again
-  assigned_literal_count++; // increment the count of number of variables
-                            // assigned
+void InputReader::skip_whitespace() {
+  int c = peek();
+  while (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+    advance();
+    c = peek();
+  }
 }
 
 /*
- * function to unassign a variable
- * Arguments : literal_index - the index of the variable to unassign
+ * function to consume the characters up to and including the next newline
  */
-void SATSolverCDCL::unassign_literal(int literal_index) {
-  literals[literal_index] = -1;               // unassign value
-  literal_decision_level[literal_index] = -1; // unassign decision level
-  literal_antecedent[literal_index] = -1;     // unassign antecedent
-  literal_frequency[literal_index] =
-      original_literal_frequency[literal_index]; // restore frequency count
-  assigned_literal_count--; // decrement the count of the number of variables
-                            // assigned
+void InputReader::skip_line() {
+  int c = peek();
+  while (c != EOF && c != '\n') {
+    advance();
+    c = peek();
+  }
+  if (c == '\n') {
+    advance();
+  }
 }
 
 /*
- * function to convert the one indexed signed form of the literal to the zero
- * indexed vector index Arguments : variable - the one indexed signed form
- * Return value : the zero indexed vector index
+ * function to read a word after skipping whitespace
+ * Arguments : word - to store the word
+ * Return value : true, if a word was read, false, at the end of the input
  */
-int SATSolverCDCL::literal_to_variable_index(int variable) {
-  return (variable > 0) ? variable - 1 : -variable - 1;
+bool InputReader::read_word(string &word) {
+  skip_whitespace();
+  word.clear();
+  int c = peek();
+  while (c != EOF && c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+    word.push_back(c);
+    advance();
+    c = peek();
+  }
+  return !word.empty();
 }
 
 /*
- * function to perform conflict analysis and backtrack
- * Arguments : decision_level - the decision level of the conflict
- * Return value : the backtracked decision level
+ * function to read a signed decimal integer after skipping whitespace
+ * Arguments : value - to store the integer
+ * Return value : true, if an integer was read, false, if the input does not
+ * continue with one
  */
-int SATSolverCDCL::conflict_analysis_and_backtrack(int decision_level) {
-  // the new clause to learn, initialized with the antecedent of the conflict
-  vector<int> learnt_clause = literal_list_per_clause[kappa_antecedent];
-  int conflict_decision_level = decision_level;
-  int this_level_count =
-      0;                // number of literals from the same decision level found
-  int resolver_literal; // literal whose antecedent will next be used to resolve
-  int literal;          // to store the index
-  do {
-    this_level_count = 0;
-    // iterate over all literals
-    for (int i = 0; i < learnt_clause.size(); i++) {
-      literal = literal_to_variable_index(learnt_clause[i]); // get the index
-      // if a literal at the same decision level has been found
-      if (literal_decision_level[literal] == conflict_decision_level) {
-        this_level_count++;
-      }
-      // if a literal at the same decision level has been found with an
-      // antecedent
-      if (literal_decision_level[literal] == conflict_decision_level &&
-          literal_antecedent[literal] != -1) {
-        // the antecedent could be used to resolve if a UIP has not been found
-        resolver_literal = literal;
-      }
-    }
-    // exactly one literal at the same decision level means we have a UIP
-    if (this_level_count == 1) {
-      break;
-    }
-    // otherwise resolve with the antecedent of the candidate resolver literal
-    learnt_clause = resolve(learnt_clause, resolver_literal);
-  } while (true);
-  literal_list_per_clause.push_back(
-      learnt_clause); // add the learnt clause to the list
-  // update the polarities and frequencies from the learnt clause
-  for (int i = 0; i < learnt_clause.size(); i++) {
-    int literal_index = literal_to_variable_index(learnt_clause[i]);
-    int update = (learnt_clause[i] > 0) ? 1 : -1;
-    literal_polarity[literal_index] += update;
-    // update frequency only if it is not currently assigned, else only update
-    // the backup
-    if (literal_frequency[literal_index] != -1) {
-      literal_frequency[literal_index]++;
-    }
-    original_literal_frequency[literal_index]++;
+bool InputReader::read_integer(int &value) {
+  skip_whitespace();
+  bool negative = false;
+  if (peek() == '-') {
+    negative = true;
+    advance();
   }
-  clause_count++;                     // increment the clause count
-  int backtracked_decision_level = 0; // decision level to backtrack to
-  for (int i = 0; i < learnt_clause.size(); i++) {
-    int literal_index = literal_to_variable_index(learnt_clause[i]);
-    int decision_level_here = literal_decision_level[literal_index];
-    // find the maximum decision level in the clause other than the conflict
-    // decision level
-    if (decision_level_here != conflict_decision_level &&
-        decision_level_here > backtracked_decision_level) {
-      backtracked_decision_level = decision_level_here;
-    }
+  int c = peek();
+  if (c < '0' || c > '9') {
+    return false;
   }
-  for (int i = 0; i < literals.size(); i++) {
-    if (literal_decision_level[i] > backtracked_decision_level) {
-      unassign_literal(
-          i); // unassign all literals above the level we backtrack to
+  long long magnitude = 0;
+  while (c >= '0' && c <= '9') {
+    magnitude = 10 * magnitude + (c - '0');
+    if (magnitude > INT32_MAX) {
+      return false; // too large to be a literal
     }
+    advance();
+    c = peek();
   }
-  return backtracked_decision_level; // return the level we are at now
+  value = negative ? -magnitude : magnitude;
+  return true;
+}
+
+// largest learnt clause that a portfolio worker shares with the others
+const int max_shared_clause_size = 8;
+
+/*
+ * class to share learnt clauses between the workers of a portfolio without
+ * locks. every worker writes the clauses it exports into its own ring buffer,
+ * each as its size followed by its literals. it reserves the words by
+ * advancing the count of words reserved before writing them, and publishes
+ * them by advancing the count of words written afterwards. the other workers
+ * read every ring from their own positions, skip ahead when the writer has
+ * lapped them, and discard what they read if the writer has reserved words
+ * over it meanwhile
+ */
+class ClauseExchange {
+private:
+  /*
+   * ring buffer written by a single worker
+   */
+  struct Ring {
+    unique_ptr<atomic<int>[]> words; // the words, written and read relaxed
+    atomic<long long> reserved;      // total number of words reserved
+    atomic<long long> written;       // total number of words published
+  };
+
+  int worker_count;         // number of workers sharing clauses
+  long long capacity;       // number of words in every ring, a power of 2
+  unique_ptr<Ring[]> rings; // the ring of every worker
+  // for every reader, the position up to which it has read every ring
+  vector<vector<long long>> read_position;
+
+public:
+  ClauseExchange(int, long long);               // constructor
+  void export_clause(int, const vector<int> &); // to publish a clause
+  void import_clauses(int, vector<int> &); // to collect the others' clauses
+};
+
+/*
+ * the constructor, which creates empty rings
+ * Arguments : workers - the number of workers, ring_words - the number of
+ * words in every ring, which must be a power of 2
+ */
+ClauseExchange::ClauseExchange(int workers, long long ring_words)
+    : worker_count(workers), capacity(ring_words), rings(new Ring[workers]),
+      read_position(workers, vector<long long>(workers, 0)) {
+  for (int i = 0; i < workers; i++) {
+    rings[i].words.reset(new atomic<int>[ring_words]);
+    rings[i].reserved.store(0);
+    rings[i].written.store(0);
+  }
+}
+
+/*
+ * function to publish a clause to the other workers. only the worker owning
+ * the ring may call this
+ * Arguments : worker - the index of the exporting worker, clause - the
+ * literals of the clause
+ */
+void ClauseExchange::export_clause(int worker, const vector<int> &clause) {
+  Ring &ring = rings[worker];
+  long long position = ring.written.load(memory_order_relaxed);
+  // the fence orders the reservation before the words, so that a reader that
+  // sees any of the words also sees the reservation
+  ring.reserved.store(position + 1 + clause.size(), memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  ring.words[position & (capacity - 1)].store(clause.size(),
+                                              memory_order_relaxed);
+  for (int i = 0; i < clause.size(); i++) {
+    ring.words[(position + 1 + i) & (capacity - 1)].store(
+        clause[i], memory_order_relaxed);
+  }
+  // the release makes the words visible to a reader that sees the new count
+  ring.written.store(position + 1 + clause.size(), memory_order_release);
 }
 
 /*
- * function to resolve a clause with the antecedent of a literal and return the
- * result Arguments : input_clause - the existing clause literal - the literal
- * whose antecedent must be resolved with Return value : the
- * resultant clause
+ * function to collect the clauses published by the other workers since the
+ * last call. the words read from a ring are discarded if its writer may have
+ * overwritten them meanwhile
+ * Arguments : worker - the index of the importing worker, clauses - to append
+ * the clauses to, each as its size followed by its literals
  */
-vector<int> &SATSolverCDCL::resolve(vector<int> &input_clause, int literal) {
-  // get the second clause
-  vector<int> second_input =
-      literal_list_per_clause[literal_antecedent[literal]];
-  // concatenate the two
-  input_clause.insert(input_clause.end(), second_input.begin(),
-                      second_input.end());
-  for (int i = 0; i < input_clause.size(); i++) {
-    // remove the literal from the concatenated version
-    if (input_clause[i] == literal + 1 || input_clause[i] == -literal - 1) {
-      input_clause.erase(input_clause.begin() + i);
-      i--;
+void ClauseExchange::import_clauses(int worker, vector<int> &clauses) {
+  for (int writer = 0; writer < worker_count; writer++) {
+    if (writer == worker) {
+      continue;
+    }
+    Ring &ring = rings[writer];
+    long long start = read_position[worker][writer];
+    long long end = ring.written.load(memory_order_acquire);
+    if (end - start > capacity) {
+      start = end; // lapped, so the unread clauses are lost
+    }
+    int batch_start = clauses.size();
+    for (long long position = start; position < end; position++) {
+      clauses.push_back(
+          ring.words[position & (capacity - 1)].load(memory_order_relaxed));
     }
+    // the words are intact if the writer has not reserved words over them,
+    // including those of a clause it is still writing
+    atomic_thread_fence(memory_order_acquire);
+    if (ring.reserved.load(memory_order_relaxed) - start > capacity) {
+      clauses.resize(batch_start);
+    }
+    read_position[worker][writer] = end;
   }
-  // remove duplicates from the result
-  sort(input_clause.begin(), input_clause.end());
-  input_clause.erase(unique(input_clause.begin(), input_clause.end()),
-                     input_clause.end());
-  return input_clause; // return the result
 }
 
 /*
- * function to pick a variable and an assignment to be assigned freely next
- * Return value : the one indexed signed form of the variable where the sign
- * denotes the direction of the assignment
+ * class to hand out the cubes of cube and conquer to the worker threads. every
+ * worker starts with its own contiguous share of the cubes, which it takes in
+ * order, and steals from the end of the others' shares once its own runs out
  */
-int SATSolverCDCL::pick_branching_variable() {
-  // to generate a random integer between 1 and 10, for deciding the mechanism
-  // of choosing
-  uniform_int_distribution<int> choose_branch(1, 10);
-  // to generate a random integer corrsponding to the index of one of the
-  // literals
-  uniform_int_distribution<int> choose_literal(0, literal_count - 1);
-  int random_value = choose_branch(generator); // get the value to choose the
-                                               // branch if we have spent too
-                                               // long trying to randomly find
-                                               // an unassigned variable
-  bool too_many_attempts = false;
-  // number of attempts to find an unassigned variable randomly so far
-  int attempt_counter = 0;
-  do {
-    /*
-     * for 60% of the time or when less than half the literals have been
-     * assigned choose the literal with the highest frequency
-     */
-    if (random_value > 4 || assigned_literal_count < literal_count / 2 ||
-        too_many_attempts) {
-      pick_counter++; // increment the number of picks so far this way
-      /*
-       * if we reached 20 times the literal count, divide all frequencies by 2
-       * this favours frequencies from recently learnt clauses
-       */
-      if (pick_counter == 20 * literal_count) {
-        for (int i = 0; i < literals.size(); i++) {
-          original_literal_frequency[i] /= 2;
-          if (literal_frequency[i] != -1) {
-            literal_frequency[i] /= 2;
-          }
-        }
-        pick_counter = 0; // reset pick counter
-      }
-      // find the variable with the highest frequency out of those unassigned
-      int variable = distance(
-          literal_frequency.begin(),
-          max_element(literal_frequency.begin(), literal_frequency.end()));
-      // choose assignment based on which polarity is greater
-      if (literal_polarity[variable] >= 0) {
-        return variable + 1;
-      }
-      return -variable - 1;
-    } else // we pick the variable randomly
-    {
-      /*
-       * we try up to 10 times the number of literals to get an unassigned
-       * variable if we don't, we go back and choose the one with the highest
-       * frequency
-       */
-      while (attempt_counter < 10 * literal_count) {
-        int variable = choose_literal(generator); // pick a random variable
-        if (literal_frequency[variable] != -1)    // if unassigned
-        {
-          // choose the assignment with the higher frequency
-          if (literal_polarity[variable] >= 0) {
-            return variable + 1;
-          }
-          return -variable - 1;
-        }
-        attempt_counter++; // increment the number of attempts if we could not
-                           // find yet
-      }
-      too_many_attempts = true; // we have attempted too many times
+class CubePool {
+private:
+  /*
+   * cubes left in the share of a worker
+   */
+  struct Share {
+    mutex lock;        // to take cubes from the share
+    deque<int> cubes;  // indices of the cubes
+  };
+
+  int worker_count;          // number of workers taking cubes
+  unique_ptr<Share[]> shares; // the share of every worker
+
+public:
+  CubePool(int, int);   // constructor
+  bool take(int, int &); // to take the next cube for a worker
+};
+
+/*
+ * the constructor, which splits the cubes into contiguous shares
+ * Arguments : workers - the number of workers, cube_count - the number of
+ * cubes
+ */
+CubePool::CubePool(int workers, int cube_count)
+    : worker_count(workers), shares(new Share[workers]) {
+  for (int i = 0; i < cube_count; i++) {
+    shares[(long long)i * workers / cube_count].cubes.push_back(i);
+  }
+}
+
+/*
+ * function to take a cube for a worker, from its own share if any is left or
+ * else from the share of another worker
+ * Arguments : worker - the index of the worker, cube - to store the index of
+ * the cube taken
+ * Return value : true, if a cube was taken, false, if none is left
+ */
+bool CubePool::take(int worker, int &cube) {
+  for (int i = 0; i < worker_count; i++) {
+    Share &share = shares[(worker + i) % worker_count];
+    lock_guard<mutex> guard(share.lock);
+    if (share.cubes.empty()) {
+      continue;
+    }
+    // the owner goes forward while the others steal from the back
+    if (i == 0) {
+      cube = share.cubes.front();
+      share.cubes.pop_front();
+    } else {
+      cube = share.cubes.back();
+      share.cubes.pop_back();
     }
-  } while (too_many_attempts); // if we have attempted too many times, go back
-                               // to the first branch
+    return true;
+  }
+  return false;
 }
 
 /*
- * function to check if all variables have been assigned so far
- * Return value : true, if yes, false, if no
+ * class to write the progress lines of a solver and of the workers copied from
+ * it, one line at a time, after the column names written once
  */
-bool SATSolverCDCL::all_variables_assigned() {
-  return literal_count == assigned_literal_count;
+class ProgressReport {
+public:
+  mutex output_mutex;          // held while writing a line
+  bool header_written = false; // if the column names were written
+};
+
+/*
+ * class to write a DRAT proof, in the text or the binary format. the proof is
+ * collected in a large buffer, which is written out when full, either directly
+ * or by a background thread while the solver fills a second buffer
+ */
+class ProofWriter {
+private:
+  static const int buffer_size = 1 << 22; // bytes in every buffer
+  FILE *file;             // the proof file, nullptr when closed
+  bool binary;            // if the binary format is written
+  vector<char> buffer;    // the buffer being filled
+  int buffer_used;        // bytes used in the buffer
+  bool threaded;          // if a background thread writes the full buffers
+  vector<char> pending;   // full buffer handed to the background thread
+  int pending_used;       // bytes in the pending buffer, 0 once written
+  bool closing;           // if the background thread is to finish
+  thread writer;          // the background thread
+  mutex lock;             // to hand buffers to the background thread
+  condition_variable changed; // to signal that a buffer was handed over
+
+  void reserve(int);   // to make room in the buffer
+  void hand_over();    // to write out the buffer or hand it over
+  void write_pending(); // to write the handed over buffers, in the thread
+  void write_out(const char *, int); // to write bytes to the file
+  // to write a clause with a prefix, leaving out one literal
+  void write_clause(char, const int *, int, int);
+
+public:
+  ProofWriter();  // constructor
+  ~ProofWriter(); // destructor
+  bool open(const char *, bool, bool); // to start writing to a file
+  // to add a clause to the proof, leaving out one literal
+  void add_clause(const int *, int, int);
+  void delete_clause(const int *, int); // to delete a clause from the proof
+  void close(); // to write out everything and close the file
+};
+
+/*
+ * the constructor, which leaves the writer closed
+ */
+ProofWriter::ProofWriter()
+    : file(nullptr), binary(false), buffer_used(0), threaded(false),
+      pending_used(0), closing(false) {}
+
+/*
+ * the destructor, which writes out and closes the proof if still open
+ */
+ProofWriter::~ProofWriter() { close(); }
+
+/*
+ * function to start writing the proof to a file
+ * Arguments : path - the path of the file, binary_format - true for the
+ * binary format, false for the text one, background - true to write with a
+ * background thread
+ * Return value : true, if the file was opened, false, if not
+ */
+bool ProofWriter::open(const char *path, bool binary_format, bool background) {
+  file = fopen(path, "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  binary = binary_format;
+  threaded = background;
+  buffer.resize(buffer_size);
+  buffer_used = 0;
+  if (threaded) {
+    pending.resize(buffer_size);
+    writer = thread(&ProofWriter::write_pending, this);
+  }
+  return true;
 }
 
 /*
- * function to display the result of the solver
- * Arguments : result_status - the status that CDCL returned
+ * function to make room for a number of bytes in the buffer, handing over the
+ * buffer if they do not fit
+ * Arguments : bytes - the number of bytes
  */
-void SATSolverCDCL::show_result(int result_status) {
-  if (result_status == RetVal::r_satisfied) // if the formula is satisfiable
-  {
-    cout << "SAT" << endl;
-    for (int i = 0; i < literals.size(); i++) {
-      if (i != 0) {
-        cout << " ";
-      }
-      if (literals[i] != -1) {
-        cout << pow(-1, (literals[i] + 1)) * (i + 1);
-      } else // for literals which can take either value, arbitrarily assign
-             // them to be true
-      {
-        cout << (i + 1);
-      }
+void ProofWriter::reserve(int bytes) {
+  if (buffer_used + bytes > buffer.size()) {
+    hand_over();
+    if (bytes > buffer.size()) {
+      buffer.resize(bytes);
     }
-    cout << " 0";
-  } else // if the formula is unsatisfiable
-  {
-    cout << "UNSAT";
   }
 }
 
 /*
- * function to solve the problem by calling the CDCL() function and then showing
- * the result
+ * function to empty the buffer, by writing it out or, with the background
+ * thread, by swapping it with the pending buffer once that has been written
  */
-void SATSolverCDCL::solve() {
-  int result_status = CDCL();
-  show_result(result_status);
+void ProofWriter::hand_over() {
+  if (!threaded) {
+    write_out(buffer.data(), buffer_used);
+    buffer_used = 0;
+    return;
+  }
+  unique_lock<mutex> guard(lock);
+  changed.wait(guard, [this]() { return pending_used == 0; });
+  buffer.swap(pending);
+  pending_used = buffer_used;
+  buffer_used = 0;
+  if (buffer.size() < pending.size()) {
+    buffer.resize(pending.size());
+  }
+  changed.notify_all();
+}
+
+/*
+ * function run by the background thread, to write every buffer handed over
+ * until the writer is closed
+ */
+void ProofWriter::write_pending() {
+  unique_lock<mutex> guard(lock);
+  while (true) {
+    changed.wait(guard, [this]() { return pending_used > 0 || closing; });
+    if (pending_used == 0) {
+      return; // closing, and everything is written
+    }
+    guard.unlock();
+    write_out(pending.data(), pending_used);
+    guard.lock();
+    pending_used = 0;
+    changed.notify_all();
+  }
+}
+
+/*
+ * function to write bytes to the proof file. a proof missing some of its
+ * clauses is wrong, so the solver stops with an error when they cannot all be
+ * written, rather than go on to report a result the proof does not back
+ * Arguments : data - the bytes, size - the number of bytes
+ */
+void ProofWriter::write_out(const char *data, int size) {
+  if (fwrite(data, 1, size, file) != size) {
+    cerr << "Could not write the proof: " << strerror(errno) << endl;
+    exit(1);
+  }
+}
+
+/*
+ * function to write a clause to the buffer. in the text format, the literals
+ * follow the prefix and end with 0 on a line. in the binary format, the
+ * prefix is a byte, and every literal l is written as 2 * |l| + (l < 0) in
+ * groups of 7 bits, least significant first, ending with a 0 byte, which is
+ * its packed form plus 2
+ * Arguments : prefix - 'a' for an addition or 'd' for a deletion, clause -
+ * the packed literals, size - the number of literals, skipped - a literal to
+ * leave out, or -1
+ */
+void ProofWriter::write_clause(char prefix, const int *clause, int size,
+                               int skipped) {
+  reserve(12 * size + 4);
+  char *output = buffer.data() + buffer_used;
+  if (binary) {
+    *output++ = prefix;
+    for (int i = 0; i < size; i++) {
+      if (clause[i] == skipped) {
+        continue;
+      }
+      unsigned int value = clause[i] + 2;
+      while (value > 127) {
+        *output++ = (char)(128 | (value & 127));
+        value >>= 7;
+      }
+      *output++ = (char)value;
+    }
+    *output++ = 0;
+  } else {
+    if (prefix == 'd') {
+      *output++ = 'd';
+      *output++ = ' ';
+    }
+    for (int i = 0; i < size; i++) {
+      if (clause[i] == skipped) {
+        continue;
+      }
+      output = write_dimacs_literal(output, clause[i]);
+      *output++ = ' ';
+    }
+    *output++ = '0';
+    *output++ = '\n';
+  }
+  buffer_used = output - buffer.data();
+}
+
+/*
+ * function to add a clause to the proof
+ * Arguments : clause - the packed literals, size - the number of literals,
+ * skipped - a literal of the clause to leave out, or -1
+ */
+void ProofWriter::add_clause(const int *clause, int size, int skipped) {
+  write_clause('a', clause, size, skipped);
+}
+
+/*
+ * function to delete a clause from the proof
+ * Arguments : clause - the packed literals, size - the number of literals
+ */
+void ProofWriter::delete_clause(const int *clause, int size) {
+  write_clause('d', clause, size, -1);
+}
+
+/*
+ * function to write out the rest of the proof and close the file
+ */
+void ProofWriter::close() {
+  if (file == nullptr) {
+    return;
+  }
+  hand_over();
+  if (threaded) {
+    {
+      lock_guard<mutex> guard(lock);
+      closing = true;
+    }
+    changed.notify_all();
+    writer.join();
+  }
+  if (fclose(file) != 0) {
+    cerr << "Could not write the proof: " << strerror(errno) << endl;
+    exit(1);
+  }
+  file = nullptr;
+}
+
+/*
+ * header of a clause stored in the clause arena. it is immediately followed by
+ * the packed literals of the clause, and the clause is referred to by the
+ * offset of its header in the arena
+ */
+struct ClauseHeader {
+  uint32_t size;          // number of literals in the clause
+  uint32_t learnt : 1;    // if the clause was learnt in conflict analysis
+  uint32_t deleted : 1;   // if the clause was deleted and awaits collection
+  uint32_t relocated : 1; // if the clause was moved by garbage collection
+  uint32_t vivified : 1;  // if the clause was vivified since it was added
+  uint32_t subsumption_done : 1; // if the clause was used for subsumption
+  uint32_t lbd : 27;      // literal block distance of a learnt clause
+  union {
+    float activity;      // activity of a learnt clause
+    uint32_t relocation; // offset of the clause in the new arena once moved
+  };
+};
+
+// number of 32 bit words taken by the header of a clause in the arena
+const int clause_header_words = sizeof(ClauseHeader) / sizeof(uint32_t);
+
+/*
+ * function to initialize the solver by reading the formula in DIMACS format.
+ * comments may appear between and inside clauses, the header's counts are
+ * only used as hints, and the last clause may omit its terminating 0. the
+ * parse throughput is reported on standard error
+ * Arguments : input_path - the path of the input file, which may be gzip or xz
+ * compressed, or nullptr for standard input
+ * Return value : true, if the formula was read, false, if it could not be
+ */
+bool SATSolverCDCL::initialize(const char *input_path) {
+  const char *input_name =
+      (input_path == nullptr) ? "standard input" : input_path;
+  InputReader input;
+  if (!input.open(input_path)) {
+    cerr << "Could not open " << input_name << endl;
+    return false;
+  }
+  chrono::steady_clock::time_point parse_start = chrono::steady_clock::now();
+  // skip the comments before the header
+  input.skip_whitespace();
+  while (input.peek() == 'c') {
+    input.skip_line();
+    input.skip_whitespace();
+  }
+  string word; // to read the words of the header
+  int header_variable_count, header_clause_count; // counts in the header
+  if (!input.read_word(word) || word != "p" || !input.read_word(word) ||
+      word != "cnf" || !input.read_integer(header_variable_count) ||
+      !input.read_integer(header_clause_count) || header_variable_count < 0 ||
+      header_variable_count > max_variable || header_clause_count < 0) {
+    cerr << "Invalid DIMACS header in " << input_name << endl;
+    return false;
+  }
+  reset_formula();
+  variable_activity.resize(header_variable_count, 0);
+  literal_polarity.resize(header_variable_count, 0);
+  // reserve room for the clauses assuming three literals each, which is
+  // grown as needed
+  clause_arena.reserve((long long)header_clause_count *
+                       (clause_header_words + 3));
+
+  int literal;        // store the incoming literal value
+  vector<int> clause; // the literals of the incoming clause
+  bool clause_pending = false; // if literals were read without a 0 after them
+  // read clauses till the end of the input
+  while (true) {
+    input.skip_whitespace();
+    int next = input.peek();
+    if (next == EOF || next == '%') // '%' ends the input in some benchmarks
+    {
+      break;
+    } else if (next == 'c') // comments may appear anywhere
+    {
+      input.skip_line();
+      continue;
+    }
+    if (!input.read_integer(literal)) {
+      cerr << "Unexpected character '" << (char)next << "' in the formula"
+           << endl;
+      return false;
+    }
+    if (literal == 0) // read 0, so the clause is complete
+    {
+      if (clause.empty()) // if any clause is empty, we can stop
+      {
+        already_unsatisfied = true;
+      }
+      // remove repeated literals, so that the two watched literals are
+      // distinct
+      sort(clause.begin(), clause.end());
+      clause.erase(unique(clause.begin(), clause.end()), clause.end());
+      original_clauses.push_back(allocate_clause(clause, false));
+      clause.clear();
+      clause_pending = false;
+      continue;
+    }
+    if (!literal_in_range(literal)) {
+      cerr << "Literal " << literal << " in " << input_name
+           << " is beyond the largest variable, " << max_variable << endl;
+      return false;
+    }
+    int variable = abs(literal) - 1;
+    // variables beyond the count in the header are accepted
+    if (variable >= variable_activity.size()) {
+      variable_activity.resize(variable + 1, 0);
+      literal_polarity.resize(variable + 1, 0);
+    }
+    clause.push_back(pack_literal(literal)); // store it packed
+    // increment activity and polarity or decrement polarity of the literal
+    variable_activity[variable]++;
+    literal_polarity[variable] += (literal > 0) ? 1 : -1;
+    clause_pending = true;
+  }
+  if (clause_pending) // the last clause had no terminating 0
+  {
+    sort(clause.begin(), clause.end());
+    clause.erase(unique(clause.begin(), clause.end()), clause.end());
+    original_clauses.push_back(allocate_clause(clause, false));
+  }
+  clause_count = original_clauses.size();
+  // the activities and polarities are counted, so the variables can be added
+  add_variables(variable_activity.size());
+  double parse_seconds =
+      chrono::duration<double>(chrono::steady_clock::now() - parse_start)
+          .count();
+  double parse_megabytes = input.bytes_read() / (1024.0 * 1024.0);
+  STATISTIC(statistics.parse_seconds = parse_seconds);
+  statistics.start_time = parse_start;
+  if (!quiet) {
+    cerr << "c parsed " << literal_count << " variables and " << clause_count
+         << " clauses, " << fixed << setprecision(2) << parse_megabytes
+         << " MB in " << parse_seconds << " s ("
+         << parse_megabytes / max(parse_seconds, 1e-9) << " MB/s)" << endl;
+    cerr << "c random seed " << random_seed << endl;
+  }
+
+  for (int i = 0; i < original_clauses.size(); i++) {
+    if (clause_header(original_clauses[i]).size >= 2) {
+      watch_clause(original_clauses[i]);
+    }
+  }
+  trail.reserve(literal_count);
+  return true;
+}
+
+/*
+ * function to empty the formula and set the state of the search to its
+ * default values. the options chosen through the setters are kept, and so is
+ * the memory of the vectors, so that the next formula reuses it
+ */
+void SATSolverCDCL::reset_formula() {
+  literal_count = 0;
+  clause_count = 0;
+  already_unsatisfied = false;
+  clause_arena.clear();
+  original_clauses.clear();
+  learnt_clauses.clear();
+  wasted_words = 0;
+  learnt_words = 0;
+  kappa_antecedent = -1;
+  conflict_count = 0;
+  propagation_count = 0;
+  reduce_interval = 2000;
+  next_reduce_conflict = reduce_interval;
+  last_reduce_conflict = 0;
+  clause_activity_increment = 1;
+  level_stamp.assign(1, 0);
+  lbd_stamp = 0;
+  restart_count = 0;
+  restart_conflict_count = 0;
+  lbd_fast_average = 0;
+  lbd_slow_average = 0;
+  inprocess_interval = 5000;
+  next_inprocess_conflict = inprocess_interval;
+  last_inprocess_propagations = 0;
+  simplified_trail_size = 0;
+  ignored_clause = -1;
+  activity_increment = 1;
+  generator.seed(random_seed); // every formula starts from the same seed
+  eliminated_variable_count = 0;
+  elimination_stack.clear();
+  // the vectors indexed by variable are filled in by add_variables
+  literal_values.clear();
+  literal_antecedent.clear();
+  literal_decision_level.clear();
+  variable_activity.clear();
+  literal_polarity.clear();
+  variable_seen.clear();
+  saved_phase.clear();
+  variable_eliminated.clear();
+  // the watch lists are emptied one by one, to keep the buffers of the lists
+  for (int i = 0; i < watch_list.size(); i++) {
+    watch_list[i].clear();
+    binary_watch[i].clear();
+  }
+  watch_count = 0;
+  binary_watch_count = 0;
+  activity_heap.clear();
+  heap_position.clear();
+  trail.clear();
+  propagation_head = 0;
+  trail_level_start.clear();
+  assumptions.clear();
+  failed_assumptions.clear();
+  model.clear();
+  statistics = SolverStatistics();
+}
+
+/*
+ * function to grow the formula to a number of variables. the new variables are
+ * unassigned and go into the heap. their activities and polarities are kept
+ * if they were already counted
+ * Arguments : variable_count - the number of variables, which is left as it
+ * is if it is not larger
+ */
+void SATSolverCDCL::add_variables(int variable_count) {
+  if (variable_count <= literal_count) {
+    return;
+  }
+  // the padding lets the vectorized scans read past the last value
+  literal_values.resize(2 * variable_count + literal_value_padding, -1);
+  literal_antecedent.resize(variable_count, -1);
+  literal_decision_level.resize(variable_count, -1);
+  variable_activity.resize(max<int>(variable_count, variable_activity.size()),
+                           0);
+  literal_polarity.resize(max<int>(variable_count, literal_polarity.size()), 0);
+  variable_seen.resize(variable_count, 0);
+  saved_phase.resize(variable_count, -1);
+  variable_eliminated.resize(variable_count, 0);
+  // lists kept from an earlier formula are empty, and are not shrunk
+  if (watch_list.size() < 2 * variable_count) {
+    watch_list.resize(2 * variable_count);
+    binary_watch.resize(2 * variable_count);
+  }
+  level_stamp.resize(variable_count + 1, 0);
+  heap_position.resize(variable_count, -1);
+  trail.reserve(variable_count); // the trail never holds more
+  for (int i = literal_count; i < variable_count; i++) {
+    heap_insert(i);
+  }
+  literal_count = variable_count;
+}
+
+/*
+ * function to limit the memory taken by learnt clauses. going over the limit
+ * makes the learnt clause database get reduced before its next scheduled
+ * reduction
+ * Arguments : bytes - the limit in bytes, or 0 for no limit
+ */
+void SATSolverCDCL::set_learnt_memory_budget(long long bytes) {
+  learnt_memory_budget = bytes;
+}
+
+/*
+ * function to choose the policy for restarting the search
+ * Arguments : policy - one of the values of RestartPolicy
+ */
+void SATSolverCDCL::set_restart_policy(int policy) { restart_policy = policy; }
+
+/*
+ * function to implement the Conflict Driven Clause Learning algorithm. the
+ * current assumptions are decided first, one per decision level
+ * Return value : the return status, which is
+ *                RetVal::r_satisfied if the formula is satisfiable
+ *                RetVal::r_unsatisfied if the formula is not satisfiable,
+ *                or an assumption fails
+ */
+int SATSolverCDCL::CDCL() {
+  int decision_level = 0;  // initial decision level
+  if (already_unsatisfied) // if we had found an empty clause, we know that it
+                           // is unsatisfiable
+  {
+    return RetVal::r_unsatisfied;
+  }
+  if (assign_unit_clauses() == RetVal::r_unsatisfied) {
+    return RetVal::r_unsatisfied;
+  }
+  // initial unit propagation to find existing top level conflicts
+  int unit_propagate_result = unit_propagate(decision_level);
+  if (unit_propagate_result == RetVal::r_unsatisfied) {
+    return unit_propagate_result;
+  }
+  // the assumptions must all be decided even if every variable is assigned
+  while (decision_level < assumptions.size() || !all_variables_assigned()) {
+    if (search_stopped()) {
+      return RetVal::r_unknown;
+    }
+    // restarting keeps the learnt clauses, activities and saved phases
+    if (restart_is_due()) {
+      backtrack(0);
+      decision_level = 0;
+      restart_count++;
+      restart_conflict_count = conflict_count;
+      if (conflict_count >= next_inprocess_conflict &&
+          inprocess() == RetVal::r_unsatisfied) {
+        return RetVal::r_unsatisfied;
+      }
+    }
+    // take in the clauses shared by the other workers at the top level
+    if (decision_level == 0 && clause_exchange != nullptr) {
+      if (import_shared_clauses() == RetVal::r_unsatisfied) {
+        return RetVal::r_unsatisfied;
+      }
+    }
+    int picked_variable = -1; // the literal to decide, or -1 for none
+    if (decision_level < assumptions.size()) {
+      // the next level belongs to an assumption, which is left without a
+      // decision if it already holds
+      int assumption = assumptions[decision_level];
+      int value = literal_value(assumption);
+      if (value == 0) {
+        analyze_final(assumption);
+        return RetVal::r_unsatisfied;
+      } else if (value == -1) {
+        picked_variable = assumption;
+      }
+    } else if (all_variables_assigned()) {
+      break; // the shared clauses assigned the remaining variables
+    } else {
+      // pick the next free variable with assignment
+      picked_variable = pick_branching_variable();
+    }
+    decision_level++; // increment the current decision level
+    trail_level_start.push_back(trail.size()); // the new level starts here
+    // assign the variable at the current decision level with no antecedent
+    if (picked_variable != -1) {
+      assign_literal(picked_variable, decision_level, -1);
+      STATISTIC(statistics.decisions++);
+    }
+    /*
+     * unit propagate and backtrack repeatedly till no conflicts are left or
+     * we found that the formula is unsatisfiable
+     */
+    while (true) {
+      unit_propagate_result = unit_propagate(decision_level);
+      if (unit_propagate_result == RetVal::r_unsatisfied) {
+        // if the conflict was at the top level, the formula is unsatisfiable
+        if (decision_level == 0) {
+          return unit_propagate_result;
+        }
+        /*
+         * if not, perform the conflict analysis, learn clauses, and backtrack
+         * to a previous decision level
+         */
+        decision_level = conflict_analysis_and_backtrack(decision_level);
+        if (search_stopped()) {
+          return RetVal::r_unknown;
+        }
+        STATISTIC(if (statistics_enabled &&
+                      conflict_count % progress_interval == 0) {
+          report_progress();
+        });
+        /*
+         * reduce the learnt clauses on schedule, or when they are over the
+         * memory budget and have grown since the last reduction
+         */
+        if (conflict_count >= next_reduce_conflict ||
+            (learnt_memory_budget > 0 &&
+             learnt_words * sizeof(uint32_t) > learnt_memory_budget &&
+             conflict_count >= last_reduce_conflict + 100)) {
+          reduce_learnt_clauses();
+        }
+        // compact the arena once deleted clauses take up a fifth of it
+        if (wasted_words > clause_arena.size() / 5) {
+          collect_garbage();
+        }
+      } else // if unit propagation gave no conflicts, continue choosing another
+             // free assignment
+      {
+        break;
+      }
+    }
+  }
+  // if we reached here, all variables were successfully assigned, and the
+  // formula is satisfiable
+  return RetVal::r_satisfied;
+}
+
+/*
+ * function to assign the original unit clauses, which are not watched, at the
+ * top level
+ * Return value : RetVal::r_unsatisfied if two unit clauses contradict each
+ * other, RetVal::r_normal otherwise
+ */
+int SATSolverCDCL::assign_unit_clauses() {
+  for (int i = 0; i < original_clauses.size(); i++) {
+    ClauseHeader &header = clause_header(original_clauses[i]);
+    if (header.size == 1 && !header.deleted) {
+      int unit_literal = clause_literals(original_clauses[i])[0];
+      int value = literal_value(unit_literal);
+      if (value == 0) {
+        return RetVal::r_unsatisfied;
+      } else if (value == -1) {
+        assign_literal(unit_literal, 0, original_clauses[i]);
+      }
+    }
+  }
+  return RetVal::r_normal;
+}
+
+/*
+ * function to choose if the formula is preprocessed before the search
+ * Arguments : enabled - true to preprocess, false not to
+ */
+void SATSolverCDCL::set_preprocessing(bool enabled) {
+  preprocessing_enabled = enabled;
+}
+
+/*
+ * function to choose the seed of the random decisions. it takes effect at
+ * once, and again for every formula read afterwards. the portfolio workers
+ * use the seeds that follow it
+ * Arguments : seed - the seed
+ */
+void SATSolverCDCL::set_seed(unsigned int seed) {
+  random_seed = seed;
+  generator.seed(seed);
+}
+
+/*
+ * function to get the seed of the random decisions, which is drawn at random
+ * when the solver is made unless set_seed() is called, so that a run can be
+ * repeated
+ * Return value : the seed
+ */
+unsigned int SATSolverCDCL::get_seed() { return random_seed; }
+
+/*
+ * function to choose the fraction of the decisions made on a random variable
+ * instead of the most active one
+ * Arguments : frequency - the fraction, from 0 to 1
+ */
+void SATSolverCDCL::set_random_decision_frequency(double frequency) {
+  random_decision_frequency = frequency;
+}
+
+/*
+ * function to choose the factor by which the activities of the variables
+ * decay at every conflict. the closer it is to 1, the longer past conflicts
+ * are remembered
+ * Arguments : decay - the factor, between 0 and 1
+ */
+void SATSolverCDCL::set_activity_decay(double decay) {
+  activity_decay = decay;
+}
+
+/*
+ * function to limit the conflicts of every call to solve, after which it
+ * stops with RetVal::r_unknown. every portfolio or cube worker has the budget
+ * to itself
+ * Arguments : conflicts - the number of conflicts, 0 for no limit
+ */
+void SATSolverCDCL::set_conflict_budget(long long conflicts) {
+  conflict_budget = conflicts;
+}
+
+/*
+ * function to limit the literals propagated by every call to solve, after
+ * which it stops with RetVal::r_unknown. every portfolio or cube worker has
+ * the budget to itself
+ * Arguments : propagations - the number of literals, 0 for no limit
+ */
+void SATSolverCDCL::set_propagation_budget(long long propagations) {
+  propagation_budget = propagations;
+}
+
+/*
+ * function to limit the wall clock time of every call to solve, after which
+ * it stops with RetVal::r_unknown. preprocessing and lookahead count towards
+ * the time, but are not stopped by it
+ * Arguments : seconds - the number of seconds, 0 for no limit
+ */
+void SATSolverCDCL::set_time_budget(double seconds) { time_budget = seconds; }
+
+/*
+ * function to limit the memory taken by the clauses and their watches, as
+ * estimated by memory_bytes(), after which the search stops with
+ * RetVal::r_unknown
+ * Arguments : bytes - the number of bytes, 0 for no limit
+ */
+void SATSolverCDCL::set_memory_budget(long long bytes) {
+  memory_budget = bytes;
+}
+
+/*
+ * function to stop the search of the solver and all its workers as soon as
+ * possible, with RetVal::r_unknown. it only stores to a lock free atomic, so
+ * it is safe to call from a signal handler or another thread. the solver can
+ * be used again once clear_interrupt() is called
+ */
+void SATSolverCDCL::interrupt() {
+  interrupt_flag->store(true, memory_order_relaxed);
+}
+
+/*
+ * function to allow the search again after interrupt() was called
+ */
+void SATSolverCDCL::clear_interrupt() {
+  interrupt_flag->store(false, memory_order_relaxed);
+}
+
+/*
+ * function to count the budgets from now on, at the start of a call to solve
+ */
+void SATSolverCDCL::start_budgets() {
+  budget_conflict_start = conflict_count;
+  budget_propagation_start = propagation_count;
+  budget_start_time = chrono::steady_clock::now();
+  budget_check_countdown = 0; // look at the clock at the first check
+}
+
+/*
+ * function to estimate the memory taken by the formula being solved: the
+ * words of the arena in use, the entries of the watch and implication lists,
+ * which grow with the learnt clauses, and the vectors kept per variable and
+ * per literal for its variables. the capacity the vectors kept from a larger
+ * formula solved before, as a worker of a batch does, is not counted, so that
+ * it does not use up the budget of the next formulas
+ * Return value : the estimated number of bytes
+ */
+long long SATSolverCDCL::memory_bytes() {
+  // the same vectors as variable_bytes() counts, for a single variable
+  const long long bytes_per_variable =
+      sizeof(double) + 7 * sizeof(int) + 4 * sizeof(int8_t) +
+      2 * (sizeof(int8_t) + sizeof(CompactVector<int>) +
+           sizeof(CompactVector<BinaryWatch>) + sizeof(char));
+  return (long long)clause_arena.size() * sizeof(uint32_t) +
+         watch_count * sizeof(int) + binary_watch_count * sizeof(BinaryWatch) +
+         literal_count * bytes_per_variable;
+}
+
+/*
+ * function to count the bytes allocated for the vectors kept per variable and
+ * per literal, not counting the watches in the lists. with 4 byte integers,
+ * every variable takes 40 bytes: 8 for its activity, 4 each for its decision
+ * level, antecedent, polarity, place in the heap and its heap position,
+ * trail entry and level stamp, and 1 each for its saved phase, seen and
+ * eliminated marks and its value in the model. every literal takes 34 bytes:
+ * 1 for its value, 16 each for its watch list and implication list, and 1
+ * for its mark. a variable with its two literals takes 108 bytes in all
+ * Return value : the number of bytes
+ */
+long long SATSolverCDCL::variable_bytes() {
+  return (long long)literal_values.capacity() * sizeof(int8_t) +
+         (long long)(watch_list.capacity() + binary_watch.capacity()) *
+             sizeof(CompactVector<int>) +
+         (long long)literal_mark.capacity() * sizeof(char) +
+         (long long)variable_activity.capacity() * sizeof(double) +
+         (long long)(literal_decision_level.capacity() +
+                     literal_antecedent.capacity() +
+                     literal_polarity.capacity() + activity_heap.capacity() +
+                     heap_position.capacity() + trail.capacity() +
+                     level_stamp.capacity()) *
+             sizeof(int) +
+         (long long)(saved_phase.capacity() + variable_seen.capacity() +
+                     variable_eliminated.capacity() + model.capacity()) *
+             sizeof(int8_t);
+}
+
+/*
+ * function to simplify the original clauses before the search. failed
+ * literals are probed first, and the top level assignments are then applied
+ * to the clauses. using occurrence lists, clauses are removed by backward
+ * subsumption and shortened by self-subsuming resolution, and variables are
+ * eliminated when resolving their clauses does not add clauses, until a
+ * budget of literal visits is used up. if the formula is found to be
+ * unsatisfiable, already_unsatisfied is set
+ */
+void SATSolverCDCL::preprocess() {
+  if (already_unsatisfied || assign_unit_clauses() == RetVal::r_unsatisfied ||
+      unit_propagate(0) == RetVal::r_unsatisfied || !probe_failed_literals()) {
+    already_unsatisfied = true;
+    return;
+  }
+  /*
+   * the top level assignments are applied to the clauses below, so their
+   * antecedents are not needed, and the clauses are simplified with the watch
+   * lists out of date until they are rebuilt at the end
+   */
+  for (int i = 0; i < trail.size(); i++) {
+    literal_antecedent[literal_to_variable_index(trail[i])] = -1;
+  }
+  kappa_antecedent = -1;
+  // the implication lists are emptied too, so that deleting binary clauses
+  // does not search them
+  for (int i = 0; i < 2 * literal_count; i++) {
+    binary_watch[i].clear();
+  }
+  binary_watch_count = 0;
+  occurrence_list.clear();
+  occurrence_list.resize(2 * literal_count);
+  literal_mark.clear();
+  literal_mark.resize(2 * literal_count, 0);
+  subsumption_queue.clear();
+  // the number of visits of a literal in subsumption and elimination is
+  // limited in proportion to the size of the formula
+  preprocessing_budget = 2LL * clause_arena.size() + 1000000;
+  // size the occurrence lists up front to avoid growing them one by one
+  vector<int> occurrence_count(2 * literal_count, 0);
+  for (int i = 0; i < original_clauses.size(); i++) {
+    int *clause = clause_literals(original_clauses[i]);
+    for (int j = 0; j < clause_header(original_clauses[i]).size; j++) {
+      occurrence_count[clause[j]]++;
+    }
+  }
+  for (int i = 0; i < 2 * literal_count; i++) {
+    occurrence_list[i].reserve(occurrence_count[i]);
+  }
+  for (int i = 0; i < original_clauses.size(); i++) {
+    ClauseHeader &header = clause_header(original_clauses[i]);
+    int *clause = clause_literals(original_clauses[i]);
+    if (header.deleted) {
+      continue;
+    }
+    // a clause containing both l and -l is a tautology
+    bool tautology = false;
+    for (int j = 0; j < header.size; j++) {
+      tautology |= literal_mark[negate_literal(clause[j])];
+      literal_mark[clause[j]] = 1;
+    }
+    for (int j = 0; j < header.size; j++) {
+      literal_mark[clause[j]] = 0;
+    }
+    if (tautology) {
+      delete_clause(original_clauses[i]); // it is always satisfied
+      continue;
+    }
+    add_occurrences(original_clauses[i]);
+    subsumption_queue.push_back(original_clauses[i]);
+  }
+  pending_units.assign(trail.begin(), trail.end());
+  // the clauses implying the top level literals may be deleted, so the
+  // literals are kept in the proof as units
+  for (int i = 0; proof != nullptr && i < trail.size(); i++) {
+    proof->add_clause(&trail[i], 1, -1);
+  }
+  bool consistent = simplify_top_level_units() && subsume_clauses();
+  // try to eliminate the variables with the fewest occurrences first
+  vector<int> candidates;
+  for (int i = 0; i < literal_count; i++) {
+    if (variable_value(i) == -1) {
+      candidates.push_back(i);
+    }
+  }
+  sort(candidates.begin(), candidates.end(), [this](int a, int b) {
+    return occurrence_list[2 * a].size() + occurrence_list[2 * a + 1].size() <
+           occurrence_list[2 * b].size() + occurrence_list[2 * b + 1].size();
+  });
+  for (int i = 0;
+       consistent && i < candidates.size() && preprocessing_budget > 0; i++) {
+    if (variable_value(candidates[i]) == -1) {
+      consistent = eliminate_variable(candidates[i]) &&
+                   simplify_top_level_units() && subsume_clauses();
+    }
+  }
+  if (!consistent) {
+    already_unsatisfied = true;
+  }
+  // release the occurrence lists, and compact the arena, which also rebuilds
+  // the watch lists from the simplified clauses
+  vector<vector<int>>().swap(occurrence_list);
+  collect_garbage();
+  propagation_head = trail.size(); // the assignments are already applied
+  if (!quiet) {
+    cerr << "c preprocessing left " << clause_count << " clauses, with "
+         << trail.size() << " variables fixed and "
+         << eliminated_variable_count << " eliminated" << endl;
+  }
+}
+
+/*
+ * function to probe literals at the first decision level. if propagating a
+ * literal gives a conflict, its negation is implied and is assigned at the top
+ * level. every probe costs a fixed amount plus the literals it propagates, and
+ * the probing stops once a budget proportional to the formula is used up
+ * Return value : false if the formula was found to be unsatisfiable, true
+ * otherwise
+ */
+bool SATSolverCDCL::probe_failed_literals() {
+  const int probe_cost = 16; // fixed cost of a probe
+  long long budget = clause_arena.size() / 8 + 100000;
+  for (int i = 0; i < literal_count && budget > 0; i++) {
+    for (int polarity = 0; polarity < 2 && variable_value(i) == -1;
+         polarity++) {
+      int probe = variable_to_literal(i, polarity == 1);
+      trail_level_start.push_back(trail.size());
+      assign_literal(probe, 1, -1);
+      int result = unit_propagate(1);
+      budget -= probe_cost + trail.size() - trail_level_start[0];
+      backtrack(0);
+      if (result == RetVal::r_unsatisfied) {
+        int unit = negate_literal(probe);
+        assign_literal(unit, 0, -1);
+        if (proof != nullptr) {
+          proof->add_clause(&unit, 1, -1);
+        }
+        if (unit_propagate(0) == RetVal::r_unsatisfied) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+/*
+ * function to add a clause to the occurrence lists of its literals
+ * Arguments : clause_reference - the reference to the clause
+ */
+void SATSolverCDCL::add_occurrences(int clause_reference) {
+  int *clause = clause_literals(clause_reference);
+  for (int i = 0; i < clause_header(clause_reference).size; i++) {
+    occurrence_list[clause[i]].push_back(clause_reference);
+  }
+}
+
+/*
+ * function to remove a clause from the occurrence list of a literal
+ * Arguments : literal - the packed literal, clause_reference - the
+ * reference to the clause
+ */
+void SATSolverCDCL::remove_occurrence(int literal, int clause_reference) {
+  vector<int> &occurrences = occurrence_list[literal];
+  for (int i = 0; i < occurrences.size(); i++) {
+    if (occurrences[i] == clause_reference) {
+      occurrences[i] = occurrences.back();
+      occurrences.pop_back();
+      return;
+    }
+  }
+}
+
+/*
+ * function to delete an original clause while preprocessing, removing it from
+ * the occurrence lists
+ * Arguments : clause_reference - the reference to the clause
+ */
+void SATSolverCDCL::remove_clause(int clause_reference) {
+  int *clause = clause_literals(clause_reference);
+  for (int i = 0; i < clause_header(clause_reference).size; i++) {
+    remove_occurrence(clause[i], clause_reference);
+  }
+  delete_clause(clause_reference);
+}
+
+/*
+ * function to assign a unit found while preprocessing at the top level, to be
+ * simplified with later
+ * Arguments : literal - the packed literal
+ * Return value : false if the literal is already false, true otherwise
+ */
+bool SATSolverCDCL::add_top_level_unit(int literal) {
+  int value = literal_value(literal);
+  if (value == -1) {
+    assign_literal(literal, 0, -1);
+    pending_units.push_back(literal);
+  }
+  return value != 0;
+}
+
+/*
+ * function to remove a literal from a clause while preprocessing. the clause
+ * is queued for subsumption, and becomes a top level unit if one literal
+ * remains
+ * Arguments : clause_reference - the reference to the clause, literal - the
+ * packed literal to remove
+ * Return value : false if the formula was found to be unsatisfiable, true
+ * otherwise
+ */
+bool SATSolverCDCL::strengthen_clause(int clause_reference, int literal) {
+  ClauseHeader &header = clause_header(clause_reference);
+  int *clause = clause_literals(clause_reference);
+  if (proof != nullptr) {
+    proof->add_clause(clause, header.size, literal);
+    proof->delete_clause(clause, header.size);
+  }
+  int position = find(clause, clause + header.size, literal) - clause;
+  copy(clause + position + 1, clause + header.size, clause + position);
+  header.size--;
+  wasted_words++; // the last word is left behind until garbage collection
+  remove_occurrence(literal, clause_reference);
+  if (header.size == 0) {
+    return false;
+  } else if (header.size == 1) {
+    int unit_literal = clause[0];
+    remove_clause(clause_reference);
+    return add_top_level_unit(unit_literal);
+  }
+  subsumption_queue.push_back(clause_reference);
+  return true;
+}
+
+/*
+ * function to simplify the clauses with the pending top level units, deleting
+ * the satisfied clauses and removing the false literals
+ * Return value : false if the formula was found to be unsatisfiable, true
+ * otherwise
+ */
+bool SATSolverCDCL::simplify_top_level_units() {
+  while (!pending_units.empty()) {
+    int literal = pending_units.back();
+    pending_units.pop_back();
+    vector<int> &satisfied = occurrence_list[literal];
+    while (!satisfied.empty()) {
+      remove_clause(satisfied.back());
+    }
+    vector<int> &falsified = occurrence_list[negate_literal(literal)];
+    while (!falsified.empty()) {
+      if (!strengthen_clause(falsified.back(), negate_literal(literal))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/*
+ * function to run backward subsumption and self-subsuming resolution with the
+ * queued clauses. a clause C removes every clause containing it, and removes
+ * the literal -l from every clause containing -l and the rest of C, for a
+ * literal l of C. the candidates are found through the occurrence lists of
+ * the literal of C that occurs least, in either polarity
+ * Return value : false if the formula was found to be unsatisfiable, true
+ * otherwise
+ */
+bool SATSolverCDCL::subsume_clauses() {
+  vector<int> candidates; // clauses that C may subsume or strengthen
+  while (!subsumption_queue.empty()) {
+    int clause_reference = subsumption_queue.back();
+    subsumption_queue.pop_back();
+    if (clause_header(clause_reference).deleted) {
+      continue;
+    }
+    if (preprocessing_budget <= 0) {
+      subsumption_queue.clear(); // the remaining clauses are left as they are
+      break;
+    }
+    int size = clause_header(clause_reference).size;
+    int *clause = clause_literals(clause_reference);
+    int least_literal = clause[0];
+    for (int i = 0; i < size; i++) {
+      literal_mark[clause[i]] = 1;
+      if (occurrence_list[clause[i]].size() +
+              occurrence_list[negate_literal(clause[i])].size() <
+          occurrence_list[least_literal].size() +
+              occurrence_list[negate_literal(least_literal)].size()) {
+        least_literal = clause[i];
+      }
+    }
+    candidates = occurrence_list[least_literal];
+    vector<int> &negated = occurrence_list[negate_literal(least_literal)];
+    candidates.insert(candidates.end(), negated.begin(), negated.end());
+    for (int i = 0; i < candidates.size(); i++) {
+      int other_reference = candidates[i];
+      ClauseHeader &other_header = clause_header(other_reference);
+      if (other_reference == clause_reference || other_header.deleted ||
+          other_header.size < size) {
+        continue;
+      }
+      int *other = clause_literals(other_reference);
+      preprocessing_budget -= other_header.size;
+      int matched = 0;       // literals of C found in the other clause
+      int negated_count = 0; // negations of literals of C found there
+      int negated_literal = -1;
+      for (int j = 0; j < other_header.size; j++) {
+        if (literal_mark[other[j]]) {
+          matched++;
+        } else if (literal_mark[negate_literal(other[j])]) {
+          negated_count++;
+          negated_literal = other[j];
+        }
+      }
+      if (matched == size) {
+        remove_clause(other_reference);
+      } else if (matched == size - 1 && negated_count == 1) {
+        if (!strengthen_clause(other_reference, negated_literal)) {
+          return false;
+        }
+      }
+    }
+    for (int i = 0; i < size; i++) {
+      literal_mark[clause[i]] = 0;
+    }
+    if (!simplify_top_level_units()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+ * function to eliminate a variable by replacing the clauses containing it with
+ * all their non tautological resolvents on it. this is only done when the
+ * resolvents are no more than the clauses they replace and are not too long.
+ * the replaced clauses are saved on the elimination stack
+ * Arguments : variable - the zero indexed variable
+ * Return value : false if the formula was found to be unsatisfiable, true
+ * otherwise
+ */
+bool SATSolverCDCL::eliminate_variable(int variable) {
+  const int occurrence_limit = 16; // clauses of either polarity to consider
+  const int resolvent_limit = 20;  // literals in a resolvent
+  int positive = variable_to_literal(variable, false);
+  vector<int> positive_clauses = occurrence_list[positive];
+  vector<int> negative_clauses = occurrence_list[negate_literal(positive)];
+  if (positive_clauses.size() > occurrence_limit ||
+      negative_clauses.size() > occurrence_limit) {
+    return true;
+  }
+  // collect the resolvents, each as its literals followed by its size
+  vector<int> resolvents;
+  int resolvent_count = 0;
+  bool too_large = false; // if eliminating would make the formula larger
+  int clause_limit = positive_clauses.size() + negative_clauses.size();
+  for (int i = 0; i < positive_clauses.size(); i++) {
+    int *first = clause_literals(positive_clauses[i]);
+    int first_size = clause_header(positive_clauses[i]).size;
+    for (int k = 0; k < first_size; k++) {
+      literal_mark[first[k]] = 1;
+    }
+    for (int j = 0; j < negative_clauses.size(); j++) {
+      int *second = clause_literals(negative_clauses[j]);
+      int second_size = clause_header(negative_clauses[j]).size;
+      int resolvent_start = resolvents.size();
+      bool tautology = false;
+      preprocessing_budget -= first_size + second_size;
+      for (int k = 0; k < first_size; k++) {
+        if (first[k] != positive) {
+          resolvents.push_back(first[k]);
+        }
+      }
+      for (int k = 0; k < second_size && !tautology; k++) {
+        if (second[k] == negate_literal(positive) || literal_mark[second[k]]) {
+          continue;
+        }
+        tautology = literal_mark[negate_literal(second[k])];
+        resolvents.push_back(second[k]);
+      }
+      int resolvent_size = resolvents.size() - resolvent_start;
+      if (tautology) {
+        resolvents.resize(resolvent_start);
+        continue;
+      }
+      resolvents.push_back(resolvent_size);
+      resolvent_count++;
+      too_large =
+          resolvent_count > clause_limit || resolvent_size > resolvent_limit;
+      if (too_large) {
+        break;
+      }
+    }
+    for (int k = 0; k < first_size; k++) {
+      literal_mark[first[k]] = 0;
+    }
+    if (too_large) {
+      return true;
+    }
+  }
+  // the resolvents are implied by the clauses they replace, so they are added
+  // to the proof before those are deleted
+  for (int end = resolvents.size(); proof != nullptr && end > 0;) {
+    int size = resolvents[end - 1];
+    proof->add_clause(resolvents.data() + end - 1 - size, size, -1);
+    end -= size + 1;
+  }
+  // save the replaced clauses with the literal of the variable first
+  vector<int> *occurrences[] = {&positive_clauses, &negative_clauses};
+  for (int l = 0; l < 2; l++) {
+    for (int i = 0; i < occurrences[l]->size(); i++) {
+      int clause_reference = (*occurrences[l])[i];
+      int *clause = clause_literals(clause_reference);
+      int size = clause_header(clause_reference).size;
+      int pivot = (l == 0) ? positive : negate_literal(positive);
+      elimination_stack.push_back(pivot);
+      for (int k = 0; k < size; k++) {
+        if (clause[k] != pivot) {
+          elimination_stack.push_back(clause[k]);
+        }
+      }
+      elimination_stack.push_back(size);
+      remove_clause(clause_reference);
+    }
+  }
+  variable_eliminated[variable] = 1;
+  eliminated_variable_count++;
+  // add the resolvents, reading them backwards by their sizes
+  vector<int> resolvent;
+  for (int end = resolvents.size(); end > 0;) {
+    int size = resolvents[end - 1];
+    resolvent.assign(resolvents.begin() + end - 1 - size,
+                     resolvents.begin() + end - 1);
+    end -= size + 1;
+    if (size == 0) {
+      return false;
+    } else if (size == 1) {
+      if (!add_top_level_unit(resolvent[0])) {
+        return false;
+      }
+      continue;
+    }
+    int clause_reference = allocate_clause(resolvent, false);
+    original_clauses.push_back(clause_reference);
+    add_occurrences(clause_reference);
+    subsumption_queue.push_back(clause_reference);
+    clause_count++;
+  }
+  return true;
+}
+
+/*
+ * function to extend a model of the simplified formula to the eliminated
+ * variables. the saved clauses are visited in the reverse order of their
+ * elimination, and every clause not yet satisfied is satisfied by its
+ * eliminated variable
+ */
+void SATSolverCDCL::extend_model() {
+  for (int i = 0; i < literal_count; i++) {
+    if (variable_eliminated[i]) {
+      literal_values[variable_to_literal(i, false)] = 1;
+      literal_values[variable_to_literal(i, true)] = 0;
+    }
+  }
+  for (int end = elimination_stack.size(); end > 0;) {
+    int size = elimination_stack[end - 1];
+    int start = end - 1 - size;
+    if (scan_literals(literal_values.data(), &elimination_stack[start], size,
+                      true) == size) {
+      int pivot = elimination_stack[start];
+      literal_values[pivot] = 1;
+      literal_values[negate_literal(pivot)] = 0;
+    }
+    end = start;
+  }
+}
+
+/*
+ * function to extend the model to the eliminated variables, and to check it
+ * against the clauses of the formula kept by the solver and those removed by
+ * eliminating variables. the clauses removed as subsumed or satisfied at the
+ * top level are implied by those checked
+ * Return value : RetVal::r_satisfied if the model satisfies the formula,
+ * RetVal::r_unknown if it does not, which is reported on standard error
+ */
+int SATSolverCDCL::finish_model() {
+  extend_model();
+  bool satisfied = true;
+  for (int i = 0; i < original_clauses.size() && satisfied; i++) {
+    ClauseHeader &header = clause_header(original_clauses[i]);
+    satisfied = header.deleted ||
+                scan_literals(literal_values.data(),
+                              clause_literals(original_clauses[i]),
+                              header.size, true) < header.size;
+  }
+  for (int end = elimination_stack.size(); end > 0 && satisfied;) {
+    int size = elimination_stack[end - 1];
+    int start = end - 1 - size;
+    satisfied = scan_literals(literal_values.data(), &elimination_stack[start],
+                              size, true) < size;
+    end = start;
+  }
+  if (!satisfied) {
+    cerr << "c the model does not satisfy the formula" << endl;
+    return RetVal::r_unknown;
+  }
+  return RetVal::r_satisfied;
+}
+
+/*
+ * function to perform unit propagation on the formula using two watched
+ * literals. only the clauses watching the negation of a newly assigned literal
+ * are visited. binary clauses are propagated first from the implication list,
+ * without reading the clauses
+ * Arguments : decision_level - the current decision level at which unit
+ * propagation is taking place Return value : Return state denoting the status,
+ * where RetVal::r_normal - unit propagation ended successfully with no
+ * conflicts RetVal::r_unsatisfied - unit propagation found a
+ * conflict
+ */
+int SATSolverCDCL::unit_propagate(int decision_level) {
+  TIME_SCOPE(statistics.propagate_seconds);
+  // propagate every literal on the trail that has not been propagated yet
+  while (propagation_head < trail.size()) {
+    // literal that became false
+    int false_literal = negate_literal(trail[propagation_head++]);
+    propagation_count++;
+    CompactVector<BinaryWatch> &implications = binary_watch[false_literal];
+    for (int i = 0; i < implications.size(); i++) {
+      int other_literal = implications[i].literal;
+      int value = literal_value(other_literal);
+      if (value == 1) {
+        continue; // the clause is satisfied
+      } else if (value == 0) {
+        kappa_antecedent = implications[i].clause_reference;
+        return RetVal::r_unsatisfied; // both literals are false
+      }
+      assign_literal(other_literal, decision_level,
+                     binary_antecedent(false_literal));
+    }
+    CompactVector<int> &watchers = watch_list[false_literal];
+    int kept = 0; // number of clauses that still watch false_literal
+    for (int i = 0; i < watchers.size(); i++) {
+      int clause_index = watchers[i];
+      ClauseHeader &header = clause_header(clause_index);
+      // deleted clauses stop being watched the next time they are visited
+      if (header.deleted) {
+        continue;
+      }
+      int *clause = clause_literals(clause_index);
+      // keep the false watched literal in the second position
+      if (clause[0] == false_literal) {
+        swap(clause[0], clause[1]);
+      }
+      // if the other watched literal is true, the clause is satisfied
+      if (literal_value(clause[0]) == 1) {
+        watchers[kept++] = clause_index;
+        continue;
+      }
+      // look for a literal that is not false to watch instead
+      int j = 2 + scan_literals(literal_values.data(), clause + 2,
+                                header.size - 2, false);
+      if (j < header.size) {
+        swap(clause[1], clause[j]);
+        watch_list[clause[1]].push_back(clause_index);
+        watch_count++;
+        continue;
+      }
+      // the clause is either unit or unsatisfied, and stays watched. the
+      // clause being vivified is not propagated
+      watchers[kept++] = clause_index;
+      if (clause_index == ignored_clause) {
+        continue;
+      } else if (literal_value(clause[0]) == 0) {
+        // unsatisfied clause, so keep the remaining watchers and stop
+        for (i++; i < watchers.size(); i++) {
+          watchers[kept++] = watchers[i];
+        }
+        watch_count -= watchers.size() - kept;
+        watchers.shrink(kept);
+        kappa_antecedent = clause_index; // set the antecedent of kappa
+        return RetVal::r_unsatisfied;    // return a conflict status
+      }
+      // assign the remaining literal at this decision level with this clause
+      // as the antecedent
+      assign_literal(clause[0], decision_level, clause_index);
+    }
+    watch_count -= watchers.size() - kept;
+    watchers.shrink(kept);
+  }
+  kappa_antecedent = -1;
+  return RetVal::r_normal; // return normally
+}
+
+/*
+ * function to make a literal true, with a decision level and antecedent for
+ * its variable
+ * Arguments : literal - the packed literal to make true, decision_level - the
+ * decision level to assign at, antecedent - the antecedent of the assignment
+ */
+void SATSolverCDCL::assign_literal(int literal, int decision_level,
+                                   int antecedent) {
+  int variable = literal_to_variable_index(literal); // get the index
+  literal_values[literal] = 1;                 // assign the literal true
+  literal_values[negate_literal(literal)] = 0; // and its negation false
+  literal_decision_level[variable] = decision_level; // set decision level
+  literal_antecedent[variable] = antecedent;         // set antecedent
+  trail.push_back(literal); // record the assignment for propagation
+}
+
+/*
+ * function to unassign a variable
+ * Arguments : literal_index - the index of the variable to unassign
+ */
+void SATSolverCDCL::unassign_literal(int literal_index) {
+  saved_phase[literal_index] = variable_value(literal_index); // save the value
+  literal_values[variable_to_literal(literal_index, false)] = -1; // unassign
+  literal_values[variable_to_literal(literal_index, true)] = -1;  // value
+  literal_decision_level[literal_index] = -1; // unassign decision level
+  literal_antecedent[literal_index] = -1;     // unassign antecedent
+  if (heap_position[literal_index] == -1) {
+    heap_insert(literal_index); // make it available for decisions again
+  }
+}
+
+/*
+ * function to undo all assignments made above a decision level. only the end
+ * of the trail holding those assignments is visited
+ * Arguments : decision_level - the decision level to backtrack to
+ */
+void SATSolverCDCL::backtrack(int decision_level) {
+  if (decision_level >= trail_level_start.size()) {
+    return; // nothing is assigned above this level
+  }
+  int level_start = trail_level_start[decision_level];
+  for (int i = trail.size() - 1; i >= level_start; i--) {
+    unassign_literal(literal_to_variable_index(trail[i]));
+  }
+  trail.resize(level_start);
+  trail_level_start.resize(decision_level);
+  propagation_head = trail.size(); // all remaining assignments are propagated
+}
+
+/*
+ * function to get the value of a literal under the current assignment
+ * Arguments : literal - the packed literal
+ * Return value : 1 if the literal is true, 0 if it is false and -1 if it is
+ * unassigned
+ */
+int SATSolverCDCL::literal_value(int literal) { return literal_values[literal]; }
+
+/*
+ * function to get the value of a variable under the current assignment
+ * Arguments : variable - the zero indexed variable
+ * Return value : 1 if the variable is true, 0 if it is false and -1 if it is
+ * unassigned
+ */
+int SATSolverCDCL::variable_value(int variable) {
+  return literal_values[variable_to_literal(variable, false)];
+}
+
+/*
+ * function to add a clause to the watch lists of its first two literals, or to
+ * the implication lists of both its literals if it is binary
+ * Arguments : clause_index - the index of the clause, which must have at least
+ * two literals
+ */
+void SATSolverCDCL::watch_clause(int clause_index) {
+  int *clause = clause_literals(clause_index);
+  if (clause_header(clause_index).size == 2) {
+    binary_watch[clause[0]].push_back({clause[1], clause_index});
+    binary_watch[clause[1]].push_back({clause[0], clause_index});
+    binary_watch_count += 2;
+    return;
+  }
+  watch_list[clause[0]].push_back(clause_index);
+  watch_list[clause[1]].push_back(clause_index);
+  watch_count += 2;
+}
+
+/*
+ * function to store a clause at the end of the clause arena
+ * Arguments : clause - the literals of the clause, learnt - if the clause was
+ * learnt in conflict analysis
+ * Return value : the reference to the stored clause
+ */
+int SATSolverCDCL::allocate_clause(const vector<int> &clause, bool learnt) {
+  int clause_reference = clause_arena.size();
+  clause_arena.resize(clause_reference + clause_header_words + clause.size());
+  ClauseHeader &header = clause_header(clause_reference);
+  header.size = clause.size();
+  header.learnt = learnt;
+  header.deleted = 0;
+  header.relocated = 0;
+  header.vivified = 0;
+  header.subsumption_done = 0;
+  header.lbd = 0;
+  header.activity = 0;
+  copy(clause.begin(), clause.end(), clause_literals(clause_reference));
+  if (learnt) {
+    learnt_words += clause_header_words + clause.size();
+  }
+  return clause_reference;
+}
+
+/*
+ * function to get the header of a clause in the arena. the reference stays
+ * valid only until the next clause is allocated
+ * Arguments : clause_reference - the reference to the clause
+ * Return value : the header of the clause
+ */
+ClauseHeader &SATSolverCDCL::clause_header(int clause_reference) {
+  return *reinterpret_cast<ClauseHeader *>(&clause_arena[clause_reference]);
+}
+
+/*
+ * function to get the literals of a clause in the arena. the pointer stays
+ * valid only until the next clause is allocated
+ * Arguments : clause_reference - the reference to the clause
+ * Return value : pointer to the first literal of the clause
+ */
+int *SATSolverCDCL::clause_literals(int clause_reference) {
+  return reinterpret_cast<int *>(
+      &clause_arena[clause_reference + clause_header_words]);
+}
+
+/*
+ * function to mark a clause as deleted. it is dropped from the watch lists
+ * when next visited and from the arena at the next garbage collection, and
+ * must not be the antecedent of any assigned variable. a binary clause is
+ * removed from the implication lists right away, since they do not read the
+ * clause to see that it is deleted
+ * Arguments : clause_reference - the reference to the clause
+ */
+void SATSolverCDCL::delete_clause(int clause_reference) {
+  ClauseHeader &header = clause_header(clause_reference);
+  if (header.size == 2) {
+    int *clause = clause_literals(clause_reference);
+    unwatch_binary_clause(clause[0], clause_reference);
+    unwatch_binary_clause(clause[1], clause_reference);
+  }
+  // unit clauses stay in the proof, since their literals stay assigned
+  if (proof != nullptr && header.size >= 2) {
+    proof->delete_clause(clause_literals(clause_reference), header.size);
+  }
+  header.deleted = 1;
+  wasted_words += clause_header_words + header.size;
+  if (header.learnt) {
+    learnt_words -= clause_header_words + header.size;
+  }
+  clause_count--;
+}
+
+/*
+ * function to count the literal block distance of a clause, which is the
+ * number of distinct decision levels among its literals
+ * Arguments : clause - the literals of the clause, which are all assigned
+ * Return value : the literal block distance
+ */
+int SATSolverCDCL::literal_block_distance(const vector<int> &clause) {
+  lbd_stamp++; // a fresh stamp marks no level as counted
+  int distance = 0;
+  for (int i = 0; i < clause.size(); i++) {
+    int level = literal_decision_level[literal_to_variable_index(clause[i])];
+    if (level_stamp[level] != lbd_stamp) {
+      level_stamp[level] = lbd_stamp;
+      distance++;
+    }
+  }
+  return distance;
+}
+
+/*
+ * function to bump the activity of a clause that took part in a conflict
+ * Arguments : clause_reference - the reference to the clause
+ */
+void SATSolverCDCL::bump_clause_activity(int clause_reference) {
+  ClauseHeader &header = clause_header(clause_reference);
+  if (!header.learnt) {
+    return; // only learnt clauses are ranked by activity
+  }
+  header.activity += clause_activity_increment;
+  // rescale all activities before they overflow, which keeps their order
+  if (header.activity > 1e20) {
+    for (int i = 0; i < learnt_clauses.size(); i++) {
+      clause_header(learnt_clauses[i]).activity *= 1e-20;
+    }
+    clause_activity_increment *= 1e-20;
+  }
+}
+
+/*
+ * function to remove a binary clause from the implication list of one of its
+ * literals, if it is there
+ * Arguments : literal - the packed literal, clause_reference - the
+ * reference to the clause
+ */
+void SATSolverCDCL::unwatch_binary_clause(int literal, int clause_reference) {
+  CompactVector<BinaryWatch> &implications = binary_watch[literal];
+  for (int i = 0; i < implications.size(); i++) {
+    if (implications[i].clause_reference == clause_reference) {
+      implications.erase(i);
+      binary_watch_count--;
+      return;
+    }
+  }
+}
+
+/*
+ * function to check if a clause is the antecedent of an assigned variable,
+ * in which case it must not be deleted. an antecedent implies its first
+ * literal, except that a binary clause may imply either, and may be the
+ * antecedent through the implication lists. a binary clause with the same
+ * literals as one of those is then locked too
+ * Arguments : clause_reference - the reference to the clause
+ * Return value : true, if yes, false, if no
+ */
+bool SATSolverCDCL::clause_is_locked(int clause_reference) {
+  int *clause = clause_literals(clause_reference);
+  bool binary = clause_header(clause_reference).size == 2;
+  for (int i = 0; i < (binary ? 2 : 1); i++) {
+    int variable = literal_to_variable_index(clause[i]);
+    if (literal_value(clause[i]) != 1) {
+      continue;
+    }
+    int antecedent = literal_antecedent[variable];
+    if (antecedent == clause_reference ||
+        (binary && antecedent == binary_antecedent(clause[1 - i]))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*
+ * function to reduce the learnt clause database, deleting the worse half of
+ * the learnt clauses that are neither glue clauses nor antecedents. clauses
+ * with a higher literal block distance are worse, and ties are broken by a
+ * lower activity
+ */
+void SATSolverCDCL::reduce_learnt_clauses() {
+  const int glue_lbd = 2; // clauses with at most this distance are kept
+  vector<int> candidates; // the learnt clauses that may be deleted
+  int kept = 0;           // number of learnt clauses that are not deleted
+  for (int i = 0; i < learnt_clauses.size(); i++) {
+    ClauseHeader &header = clause_header(learnt_clauses[i]);
+    if (header.deleted) {
+      continue;
+    }
+    learnt_clauses[kept++] = learnt_clauses[i];
+    if (header.lbd > glue_lbd && !clause_is_locked(learnt_clauses[i])) {
+      candidates.push_back(learnt_clauses[i]);
+    }
+  }
+  learnt_clauses.resize(kept);
+  sort(candidates.begin(), candidates.end(), [this](int a, int b) {
+    ClauseHeader &first = clause_header(a);
+    ClauseHeader &second = clause_header(b);
+    if (first.lbd != second.lbd) {
+      return first.lbd > second.lbd;
+    }
+    return first.activity < second.activity;
+  });
+  for (int i = 0; i < candidates.size() / 2; i++) {
+    delete_clause(candidates[i]);
+  }
+  STATISTIC(statistics.deleted_clauses += candidates.size() / 2);
+  // schedule the next reduction further away as the search goes on
+  reduce_interval += 300;
+  next_reduce_conflict = conflict_count + reduce_interval;
+  last_reduce_conflict = conflict_count;
+}
+
+/*
+ * function to compact the clause arena by moving all clauses that are not
+ * deleted into a new arena, and updating every reference to them
+ */
+void SATSolverCDCL::collect_garbage() {
+  vector<uint32_t> new_arena;
+  new_arena.reserve(clause_arena.size() - wasted_words);
+  vector<int> *clause_lists[] = {&original_clauses, &learnt_clauses};
+  for (int l = 0; l < 2; l++) {
+    vector<int> &clause_list = *clause_lists[l];
+    int kept = 0; // number of clauses remaining in the list
+    for (int i = 0; i < clause_list.size(); i++) {
+      ClauseHeader &header = clause_header(clause_list[i]);
+      if (header.deleted) {
+        continue;
+      }
+      int words = clause_header_words + header.size;
+      int new_reference = new_arena.size();
+      new_arena.insert(new_arena.end(), clause_arena.begin() + clause_list[i],
+                       clause_arena.begin() + clause_list[i] + words);
+      // leave the new location behind for the antecedents
+      header.relocated = 1;
+      header.relocation = new_reference;
+      clause_list[kept++] = new_reference;
+    }
+    clause_list.resize(kept);
+  }
+  // antecedents are never deleted, so all of them have been moved
+  for (int i = 0; i < trail.size(); i++) {
+    int variable = literal_to_variable_index(trail[i]);
+    if (literal_antecedent[variable] >= 0) {
+      literal_antecedent[variable] =
+          clause_header(literal_antecedent[variable]).relocation;
+    }
+  }
+  if (kappa_antecedent != -1) {
+    kappa_antecedent = clause_header(kappa_antecedent).relocation;
+  }
+  clause_arena.swap(new_arena);
+  wasted_words = 0;
+  // the watched literals are the first two of every clause, so the watch
+  // lists can be rebuilt from the moved clauses
+  for (int i = 0; i < 2 * literal_count; i++) {
+    watch_list[i].clear();
+    binary_watch[i].clear();
+  }
+  watch_count = 0;
+  binary_watch_count = 0;
+  for (int l = 0; l < 2; l++) {
+    vector<int> &clause_list = *clause_lists[l];
+    for (int i = 0; i < clause_list.size(); i++) {
+      if (clause_header(clause_list[i]).size >= 2) {
+        watch_clause(clause_list[i]);
+      }
+    }
+  }
+}
+
+/*
+ * function to simplify the clauses at a restart. the literals assigned at the
+ * top level are removed from the clauses, the learnt and then the original
+ * clauses are vivified, and the clauses not yet used for subsumption remove
+ * the clauses they subsume. the vivification shares a tenth of the literals
+ * propagated by the search since the last pass, and stops early when the
+ * search must stop
+ * Return value : RetVal::r_unsatisfied if the formula was found to be
+ * unsatisfiable, RetVal::r_normal otherwise
+ */
+int SATSolverCDCL::inprocess() {
+  TIME_SCOPE(statistics.inprocess_seconds);
+  const long long minimum_budget = 20000; // propagations allowed at least
+  if (unit_propagate(0) == RetVal::r_unsatisfied) {
+    return RetVal::r_unsatisfied;
+  }
+  long long budget = max(minimum_budget,
+                         (propagation_count - last_inprocess_propagations) / 10);
+  if (trail.size() > simplified_trail_size) {
+    remove_top_level_literals();
+  }
+  // vivifying assigns variables, so the saved phases are restored after it
+  vector<int8_t> phases = saved_phase;
+  int result = vivify_clauses(learnt_clauses, budget / 2);
+  if (result != RetVal::r_unsatisfied) {
+    result = vivify_clauses(original_clauses, budget / 2);
+  }
+  saved_phase.swap(phases);
+  if (result == RetVal::r_unsatisfied) {
+    return RetVal::r_unsatisfied;
+  }
+  subsume_with_new_clauses();
+  last_inprocess_propagations = propagation_count;
+  // run the passes further apart as the search goes on
+  inprocess_interval += inprocess_interval / 10;
+  next_inprocess_conflict = conflict_count + inprocess_interval;
+  return RetVal::r_normal;
+}
+
+/*
+ * function to remove the literals false at the top level from the clauses,
+ * and to delete the clauses satisfied at the top level, except antecedents.
+ * the clauses are changed in place, so the watch lists are rebuilt by
+ * collecting the garbage afterwards. every clause keeps at least two
+ * literals, as the top level assignments have been propagated
+ */
+void SATSolverCDCL::remove_top_level_literals() {
+  vector<int> *clause_lists[] = {&original_clauses, &learnt_clauses};
+  for (int l = 0; l < 2; l++) {
+    vector<int> &clause_list = *clause_lists[l];
+    for (int i = 0; i < clause_list.size(); i++) {
+      ClauseHeader &header = clause_header(clause_list[i]);
+      if (header.deleted || header.size < 2 ||
+          clause_is_locked(clause_list[i])) {
+        continue;
+      }
+      int *clause = clause_literals(clause_list[i]);
+      bool satisfied = false;
+      learnt_clause.clear(); // the literals that are not false
+      for (int j = 0; j < header.size && !satisfied; j++) {
+        int value = literal_value(clause[j]);
+        satisfied = value == 1;
+        if (value == -1) {
+          learnt_clause.push_back(clause[j]);
+        }
+      }
+      if (satisfied) {
+        delete_clause(clause_list[i]);
+        continue;
+      } else if (learnt_clause.size() == header.size) {
+        continue;
+      }
+      if (proof != nullptr) {
+        proof->add_clause(learnt_clause.data(), learnt_clause.size(), -1);
+        proof->delete_clause(clause, header.size);
+      }
+      int removed = header.size - learnt_clause.size();
+      copy(learnt_clause.begin(), learnt_clause.end(), clause);
+      header.size = learnt_clause.size();
+      wasted_words += removed; // the last words are left behind
+      if (header.learnt) {
+        learnt_words -= removed;
+      }
+    }
+  }
+  simplified_trail_size = trail.size();
+  collect_garbage();
+}
+
+/*
+ * function to vivify the clauses of a list that were not vivified yet and
+ * have at least three literals, the learnt clauses with the lowest literal
+ * block distance first, until a number of literals have been propagated
+ * Arguments : clause_list - the list of clauses, budget - the number of
+ * literals that may be propagated
+ * Return value : RetVal::r_unsatisfied if the formula was found to be
+ * unsatisfiable, RetVal::r_normal otherwise
+ */
+int SATSolverCDCL::vivify_clauses(vector<int> &clause_list, long long budget) {
+  vector<int> candidates; // the clauses to vivify, as the list grows meanwhile
+  for (int i = 0; i < clause_list.size(); i++) {
+    ClauseHeader &header = clause_header(clause_list[i]);
+    if (!header.deleted && !header.vivified && header.size >= 3) {
+      candidates.push_back(clause_list[i]);
+    }
+  }
+  stable_sort(candidates.begin(), candidates.end(), [this](int a, int b) {
+    return clause_header(a).lbd < clause_header(b).lbd;
+  });
+  long long propagation_limit = propagation_count + budget;
+  for (int i = 0; i < candidates.size() && propagation_count < propagation_limit;
+       i++) {
+    if (search_stopped()) {
+      break;
+    }
+    if (!clause_header(candidates[i]).deleted &&
+        vivify_clause(candidates[i]) == RetVal::r_unsatisfied) {
+      return RetVal::r_unsatisfied;
+    }
+  }
+  return RetVal::r_normal;
+}
+
+/*
+ * function to vivify a clause. the negations of its literals are decided in
+ * turn and propagated without the clause itself. a literal that becomes false
+ * is left out, and once a literal becomes true or a conflict arises, the
+ * literals kept so far, with the true one, already form a clause implied by
+ * the others. a clause with a literal true at the top level is deleted
+ * Arguments : clause_reference - the reference to the clause, which is not
+ * deleted
+ * Return value : RetVal::r_unsatisfied if the formula was found to be
+ * unsatisfiable, RetVal::r_normal otherwise
+ */
+int SATSolverCDCL::vivify_clause(int clause_reference) {
+  ClauseHeader &header = clause_header(clause_reference);
+  header.vivified = 1;
+  if (clause_is_locked(clause_reference)) {
+    return RetVal::r_normal;
+  }
+  int *clause = clause_literals(clause_reference);
+  vivified_literals.assign(clause, clause + header.size);
+  learnt_clause.clear(); // the literals kept
+  bool satisfied = false; // if a literal is true at the top level
+  int decision_level = 0;
+  ignored_clause = clause_reference;
+  for (int i = 0; i < vivified_literals.size(); i++) {
+    int literal = vivified_literals[i];
+    int value = literal_value(literal);
+    if (value == 0) {
+      continue; // implied false, so it can be left out
+    } else if (value == 1) {
+      satisfied =
+          literal_decision_level[literal_to_variable_index(literal)] == 0;
+      learnt_clause.push_back(literal);
+      break;
+    }
+    learnt_clause.push_back(literal);
+    decision_level++;
+    trail_level_start.push_back(trail.size());
+    assign_literal(negate_literal(literal), decision_level, -1);
+    if (unit_propagate(decision_level) == RetVal::r_unsatisfied) {
+      break;
+    }
+  }
+  backtrack(0);
+  ignored_clause = -1;
+  kappa_antecedent = -1;
+  if (satisfied) {
+    delete_clause(clause_reference);
+    return RetVal::r_normal;
+  } else if (learnt_clause.size() == vivified_literals.size()) {
+    return RetVal::r_normal;
+  }
+  STATISTIC(statistics.vivified_clauses++;
+            statistics.vivified_literals +=
+            vivified_literals.size() - learnt_clause.size());
+  return replace_clause(clause_reference);
+}
+
+/*
+ * function to replace a clause by the shorter clause in learnt_clause, whose
+ * literals are unassigned. the new clause is learnt if the old one was, and
+ * keeps its literal block distance and activity. a unit clause is assigned at
+ * the top level instead, and propagated
+ * Arguments : clause_reference - the reference to the clause to replace
+ * Return value : RetVal::r_unsatisfied if the formula was found to be
+ * unsatisfiable, RetVal::r_normal otherwise
+ */
+int SATSolverCDCL::replace_clause(int clause_reference) {
+  ClauseHeader &header = clause_header(clause_reference);
+  bool learnt = header.learnt;
+  int lbd = header.lbd;
+  float activity = header.activity;
+  // the new clause is added to the proof before the old one is deleted
+  if (proof != nullptr) {
+    proof->add_clause(learnt_clause.data(), learnt_clause.size(), -1);
+  }
+  delete_clause(clause_reference);
+  if (learnt_clause.size() == 1) {
+    assign_literal(learnt_clause[0], 0, -1);
+    return unit_propagate(0);
+  }
+  int new_reference = allocate_clause(learnt_clause, learnt);
+  ClauseHeader &new_header = clause_header(new_reference);
+  new_header.vivified = 1;
+  new_header.lbd = min<int>(lbd, learnt_clause.size());
+  new_header.activity = activity;
+  if (learnt) {
+    learnt_clauses.push_back(new_reference);
+  } else {
+    original_clauses.push_back(new_reference);
+  }
+  clause_count++;
+  watch_clause(new_reference);
+  return RetVal::r_normal;
+}
+
+/*
+ * function to remove the clauses subsumed by the clauses that were not used
+ * for subsumption yet, which are mostly those learnt or shortened since the
+ * last pass. the candidates are found through occurrence lists of all the
+ * clauses, from the literal of the subsuming clause that occurs least. a
+ * learnt clause that subsumes an original one becomes original, so that the
+ * formula keeps the constraint. the number of literals visited is limited
+ * in proportion to the size of the formula
+ */
+void SATSolverCDCL::subsume_with_new_clauses() {
+  long long budget = 2LL * clause_arena.size() + 100000; // literal visits
+  occurrence_list.clear();
+  occurrence_list.resize(2 * literal_count);
+  literal_mark.assign(2 * literal_count, 0);
+  vector<int> subsuming; // the clauses not used for subsumption yet
+  vector<int> *clause_lists[] = {&original_clauses, &learnt_clauses};
+  for (int l = 0; l < 2; l++) {
+    vector<int> &clause_list = *clause_lists[l];
+    for (int i = 0; i < clause_list.size(); i++) {
+      ClauseHeader &header = clause_header(clause_list[i]);
+      if (header.deleted || header.size < 2) {
+        continue;
+      }
+      if (!header.subsumption_done) {
+        subsuming.push_back(clause_list[i]);
+      }
+      int *clause = clause_literals(clause_list[i]);
+      for (int j = 0; j < header.size; j++) {
+        occurrence_list[clause[j]].push_back(clause_list[i]);
+      }
+    }
+  }
+  for (int i = 0; i < subsuming.size() && budget > 0; i++) {
+    ClauseHeader &header = clause_header(subsuming[i]);
+    if (header.deleted) {
+      continue;
+    }
+    header.subsumption_done = 1;
+    int *clause = clause_literals(subsuming[i]);
+    int best_literal = clause[0]; // the literal that occurs least
+    for (int j = 0; j < header.size; j++) {
+      literal_mark[clause[j]] = 1;
+      if (occurrence_list[clause[j]].size() <
+          occurrence_list[best_literal].size()) {
+        best_literal = clause[j];
+      }
+    }
+    vector<int> &candidates = occurrence_list[best_literal];
+    for (int j = 0; j < candidates.size(); j++) {
+      ClauseHeader &candidate_header = clause_header(candidates[j]);
+      if (candidates[j] == subsuming[i] || candidate_header.deleted ||
+          candidate_header.size < header.size) {
+        continue;
+      }
+      int *candidate = clause_literals(candidates[j]);
+      int marked = 0; // literals of the clause found in the candidate
+      for (int k = 0; k < candidate_header.size; k++) {
+        marked += literal_mark[candidate[k]];
+      }
+      budget -= candidate_header.size;
+      if (marked < header.size || clause_is_locked(candidates[j])) {
+        continue;
+      }
+      if (header.learnt && !candidate_header.learnt) {
+        header.learnt = 0;
+        learnt_words -= clause_header_words + header.size;
+        original_clauses.push_back(subsuming[i]);
+      } else if (header.learnt) {
+        header.lbd = min(header.lbd, candidate_header.lbd);
+      }
+      delete_clause(candidates[j]);
+      STATISTIC(statistics.subsumed_clauses++);
+    }
+    for (int j = 0; j < header.size; j++) {
+      literal_mark[clause[j]] = 0;
+    }
+  }
+  vector<vector<int>>().swap(occurrence_list); // release the lists
+  // the clauses that became original leave the learnt clauses
+  int kept = 0;
+  for (int i = 0; i < learnt_clauses.size(); i++) {
+    ClauseHeader &header = clause_header(learnt_clauses[i]);
+    if (!header.deleted && header.learnt) {
+      learnt_clauses[kept++] = learnt_clauses[i];
+    }
+  }
+  learnt_clauses.resize(kept);
+}
+
+/*
+ * function to perform conflict analysis and backtrack. the trail is walked
+ * backwards from the conflict, resolving with the antecedents of the marked
+ * literals until a single literal of the conflict decision level, the first
+ * UIP, remains. the learnt clause is then minimized by removing the literals
+ * implied by the others
+ * Arguments : decision_level - the decision level of the conflict
+ * Return value : the backtracked decision level
+ */
+int SATSolverCDCL::conflict_analysis_and_backtrack(int decision_level) {
+  TIME_SCOPE(statistics.analyze_seconds);
+  int conflict_decision_level = decision_level;
+  int this_level_count = 0; // number of marked literals from the conflict
+                            // decision level that are yet to be resolved
+  int resolver_literal = -1; // literal whose antecedent will next be used to
+                             // resolve, -1 for the conflict itself
+  int clause_reference = kappa_antecedent; // clause to resolve with next
+  int trail_index = trail.size() - 1; // position of the next trail literal to
+                                      // consider for resolution
+  conflict_count++;
+  learnt_clause.clear();
+  learnt_clause.push_back(-1); // room for the UIP
+  do {
+    this_level_count += resolve(clause_reference, resolver_literal,
+                                conflict_decision_level);
+    // walk the trail backwards to the most recently assigned marked literal
+    while (!variable_seen[literal_to_variable_index(trail[trail_index])]) {
+      trail_index--;
+    }
+    resolver_literal = trail[trail_index--];
+    int variable = literal_to_variable_index(resolver_literal);
+    variable_seen[variable] = 0;
+    clause_reference = literal_antecedent[variable];
+    this_level_count--;
+    // exactly one literal left at the conflict decision level means it is a
+    // UIP
+  } while (this_level_count > 0);
+  learnt_clause[0] = negate_literal(resolver_literal);
+  /*
+   * minimize the learnt clause, keeping the literals that are decisions or
+   * that are not implied by the other literals. the signature of the decision
+   * levels in the clause lets the search give up early on implications from
+   * other levels
+   */
+  seen_to_clear.assign(learnt_clause.begin(), learnt_clause.end());
+  unsigned int levels_in_clause = 0;
+  for (int i = 1; i < learnt_clause.size(); i++) {
+    levels_in_clause |= decision_level_signature(learnt_clause[i]);
+  }
+  int kept = 1; // number of literals kept in the learnt clause
+  for (int i = 1; i < learnt_clause.size(); i++) {
+    int variable = literal_to_variable_index(learnt_clause[i]);
+    if (literal_antecedent[variable] == -1 ||
+        !literal_is_redundant(learnt_clause[i], levels_in_clause)) {
+      learnt_clause[kept++] = learnt_clause[i];
+    }
+  }
+  learnt_clause.resize(kept);
+  for (int i = 0; i < seen_to_clear.size(); i++) {
+    variable_seen[literal_to_variable_index(seen_to_clear[i])] = 0;
+  }
+  /*
+   * find the maximum decision level in the clause other than the conflict
+   * decision level, and move a literal of that level to the second position
+   * so that the UIP and that literal are the watched literals
+   */
+  int backtracked_decision_level = 0; // decision level to backtrack to
+  for (int i = 1; i < learnt_clause.size(); i++) {
+    int decision_level_here =
+        literal_decision_level[literal_to_variable_index(learnt_clause[i])];
+    if (decision_level_here > backtracked_decision_level) {
+      backtracked_decision_level = decision_level_here;
+      swap(learnt_clause[1], learnt_clause[i]);
+    }
+  }
+  if (proof != nullptr) {
+    proof->add_clause(learnt_clause.data(), learnt_clause.size(), -1);
+  }
+  // add the learnt clause to the arena
+  int learnt_clause_index = allocate_clause(learnt_clause, true);
+  learnt_clauses.push_back(learnt_clause_index);
+  clause_header(learnt_clause_index).lbd =
+      literal_block_distance(learnt_clause);
+  update_lbd_averages(clause_header(learnt_clause_index).lbd);
+  STATISTIC(statistics.learnt_clauses++;
+            statistics.learnt_literals += learnt_clause.size();
+            statistics.learnt_lbd += clause_header(learnt_clause_index).lbd);
+  // share the short clauses that are likely to be useful
+  if (clause_exchange != nullptr &&
+      learnt_clause.size() <= max_shared_clause_size &&
+      clause_header(learnt_clause_index).lbd <= 3) {
+    clause_exchange->export_clause(worker_index, learnt_clause);
+  }
+  bump_clause_activity(learnt_clause_index); // new clauses start out active
+  // update the polarities from the learnt clause
+  for (int i = 0; i < learnt_clause.size(); i++) {
+    int literal_index = literal_to_variable_index(learnt_clause[i]);
+    int update = literal_is_negative(learnt_clause[i]) ? -1 : 1;
+    literal_polarity[literal_index] += update;
+  }
+  // decay all activities by growing the bump for the future conflicts
+  activity_increment /= activity_decay;
+  clause_activity_increment /= 0.999;
+  clause_count++; // increment the clause count
+  if (learnt_clause.size() >= 2) {
+    watch_clause(learnt_clause_index);
+  }
+  // unassign all literals above the level we backtrack to
+  backtrack(backtracked_decision_level);
+  // the learnt clause is now unit, so assign the UIP with it as the antecedent
+  assign_literal(learnt_clause[0], backtracked_decision_level,
+                 learnt_clause_index);
+  return backtracked_decision_level; // return the level we are at now
+}
+
+/*
+ * function to resolve the clause being learnt with a clause. the variables of
+ * the clause are marked as seen and bumped, and those below the conflict
+ * decision level are added to the learnt clause. top level literals are
+ * always false and are left out
+ * Arguments : clause_reference - the clause to resolve with, resolver_literal -
+ * the literal it implies, or -1 for the conflicting clause,
+ * conflict_decision_level - the decision level of the conflict
+ * Return value : the number of newly marked variables at the conflict decision
+ * level
+ */
+int SATSolverCDCL::resolve(int clause_reference, int resolver_literal,
+                           int conflict_decision_level) {
+  const int *clause;
+  int size;
+  if (resolver_literal == -1) {
+    bump_clause_activity(clause_reference); // it took part in the conflict
+    clause = clause_literals(clause_reference);
+    size = clause_header(clause_reference).size;
+  } else {
+    int variable = literal_to_variable_index(resolver_literal);
+    if (clause_reference >= 0) {
+      bump_clause_activity(clause_reference);
+    }
+    clause = antecedent_reason(variable, size);
+  }
+  int this_level_count = 0;
+  for (int i = 0; i < size; i++) {
+    int variable = literal_to_variable_index(clause[i]);
+    int level = literal_decision_level[variable];
+    if (variable_seen[variable] || level == 0) {
+      continue;
+    }
+    variable_seen[variable] = 1;
+    bump_variable_activity(variable); // it took part in the conflict
+    if (level == conflict_decision_level) {
+      this_level_count++;
+    } else {
+      learnt_clause.push_back(clause[i]);
+    }
+  }
+  return this_level_count;
+}
+
+/*
+ * function to get the literals of the antecedent of an implied variable that
+ * imply it, which are all false. for a variable implied from the implication
+ * lists this is the other literal of the binary clause, and the clause is not
+ * read. the pointer is valid until the next call
+ * Arguments : variable - the index of the variable, size - set to the number
+ * of literals
+ * Return value : a pointer to the literals
+ */
+const int *SATSolverCDCL::antecedent_reason(int variable, int &size) {
+  int clause_reference = literal_antecedent[variable];
+  if (clause_reference < -1) {
+    size = 1;
+    binary_reason = binary_antecedent(clause_reference);
+    return &binary_reason;
+  }
+  // an antecedent implies its first literal from the others
+  size = clause_header(clause_reference).size - 1;
+  return clause_literals(clause_reference) + 1;
+}
+
+/*
+ * function to check if a literal of the learnt clause is implied by its other
+ * literals, by following antecedents depth first until only literals of the
+ * learnt clause remain. the variables shown to be implied stay marked, so that
+ * they are not explored again
+ * Arguments : literal - the literal of the learnt clause, levels_in_clause -
+ * the signature of the decision levels in the learnt clause
+ * Return value : true, if yes, false, if no
+ */
+bool SATSolverCDCL::literal_is_redundant(int literal,
+                                         unsigned int levels_in_clause) {
+  minimize_stack.clear();
+  minimize_stack.push_back(literal);
+  int clear_from = seen_to_clear.size(); // marks to undo if not redundant
+  while (!minimize_stack.empty()) {
+    int variable = literal_to_variable_index(minimize_stack.back());
+    minimize_stack.pop_back();
+    int size;
+    const int *clause = antecedent_reason(variable, size);
+    for (int i = 0; i < size; i++) {
+      int next_variable = literal_to_variable_index(clause[i]);
+      if (variable_seen[next_variable] ||
+          literal_decision_level[next_variable] == 0) {
+        continue;
+      }
+      // a decision, or a literal from a level outside the clause, cannot be
+      // implied by the clause
+      if (literal_antecedent[next_variable] == -1 ||
+          !(decision_level_signature(clause[i]) & levels_in_clause)) {
+        for (int j = clear_from; j < seen_to_clear.size(); j++) {
+          variable_seen[literal_to_variable_index(seen_to_clear[j])] = 0;
+        }
+        seen_to_clear.resize(clear_from);
+        return false;
+      }
+      variable_seen[next_variable] = 1;
+      minimize_stack.push_back(clause[i]);
+      seen_to_clear.push_back(clause[i]);
+    }
+  }
+  return true;
+}
+
+/*
+ * function to get a signature bit for the decision level of a literal, so that
+ * a set of levels can be approximated by a bitwise or of their signatures
+ * Arguments : literal - an assigned packed literal
+ * Return value : the signature bit of its decision level
+ */
+unsigned int SATSolverCDCL::decision_level_signature(int literal) {
+  return 1u
+         << (literal_decision_level[literal_to_variable_index(literal)] & 31);
+}
+
+/*
+ * function to add the literal block distance of a new learnt clause to the
+ * moving averages. while there are few conflicts, a larger weight is given to
+ * each so that the averages start out as plain means
+ * Arguments : lbd - the literal block distance of the learnt clause
+ */
+void SATSolverCDCL::update_lbd_averages(int lbd) {
+  double fast_weight = max(1.0 / 32, 1.0 / conflict_count);
+  double slow_weight = max(1.0 / 4096, 1.0 / conflict_count);
+  lbd_fast_average += fast_weight * (lbd - lbd_fast_average);
+  lbd_slow_average += slow_weight * (lbd - lbd_slow_average);
+}
+
+/*
+ * function to check if the search should restart according to the restart
+ * policy
+ * Return value : true, if yes, false, if no
+ */
+bool SATSolverCDCL::restart_is_due() {
+  const long long luby_unit = 100; // conflicts in a unit of the Luby series
+  const long long glucose_min_conflicts = 50; // conflicts between restarts
+  const double glucose_margin = 1.25; // excess of the fast average needed
+  long long conflicts_since_restart = conflict_count - restart_conflict_count;
+  if (restart_policy == RestartPolicy::rp_luby) {
+    return conflicts_since_restart >= luby_unit * luby(restart_count);
+  } else if (restart_policy == RestartPolicy::rp_glucose) {
+    return conflicts_since_restart >= glucose_min_conflicts &&
+           lbd_fast_average > glucose_margin * lbd_slow_average;
+  }
+  return false;
+}
+
+/*
+ * function to get a term of the Luby series 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, ...
+ * Arguments : index - the zero indexed position of the term
+ * Return value : the term
+ */
+long long SATSolverCDCL::luby(long long index) {
+  // find the smallest complete subsequence, of size 2^k - 1, containing the
+  // index, and descend into the copy of the previous one it falls in
+  long long size = 1;
+  int power = 0;
+  while (size < index + 1) {
+    power++;
+    size = 2 * size + 1;
+  }
+  while (size - 1 != index) {
+    size = (size - 1) >> 1;
+    power--;
+    index = index % size;
+  }
+  return 1LL << power;
+}
+
+/*
+ * function to pick a variable and an assignment to be assigned freely next
+ * Return value : the packed literal of the variable, whose sign denotes the
+ * direction of the assignment
+ */
+int SATSolverCDCL::pick_branching_variable() {
+  TIME_SCOPE(statistics.decide_seconds);
+  // to generate a random number for deciding the mechanism of choosing
+  uniform_real_distribution<double> choose_branch(0, 1);
+  int variable = -1;
+  // occasionally pick a random variable from the heap, which is kept if it is
+  // assigned and removed later
+  if (choose_branch(generator) < random_decision_frequency &&
+      !activity_heap.empty()) {
+    uniform_int_distribution<int> choose_position(0, activity_heap.size() - 1);
+    variable = activity_heap[choose_position(generator)];
+  }
+  // otherwise pick the unassigned variable with the highest activity,
+  // discarding the assigned variables on the way
+  while (variable == -1 || variable_value(variable) != -1 ||
+         variable_eliminated[variable]) {
+    variable = heap_remove_max();
+  }
+  // reuse the last value of the variable if it had one
+  if (saved_phase[variable] != -1) {
+    return variable_to_literal(variable, saved_phase[variable] == 0);
+  }
+  // otherwise choose assignment based on which polarity is greater
+  return variable_to_literal(variable, literal_polarity[variable] < 0);
+}
+
+/*
+ * function to bump the activity of a variable that took part in a conflict
+ * Arguments : variable - the zero indexed variable
+ */
+void SATSolverCDCL::bump_variable_activity(int variable) {
+  variable_activity[variable] += activity_increment;
+  // rescale all activities before they overflow, which keeps their order
+  if (variable_activity[variable] > 1e100) {
+    for (int i = 0; i < literal_count; i++) {
+      variable_activity[i] *= 1e-100;
+    }
+    activity_increment *= 1e-100;
+  }
+  if (heap_position[variable] != -1) {
+    heap_percolate_up(heap_position[variable]); // its activity only grew
+  }
+}
+
+/*
+ * function to insert a variable into the activity heap
+ * Arguments : variable - the zero indexed variable, which is not in the heap
+ */
+void SATSolverCDCL::heap_insert(int variable) {
+  heap_position[variable] = activity_heap.size();
+  activity_heap.push_back(variable);
+  heap_percolate_up(activity_heap.size() - 1);
+}
+
+/*
+ * function to remove the variable with the highest activity from the heap
+ * Return value : the zero indexed variable, the heap must not be empty
+ */
+int SATSolverCDCL::heap_remove_max() {
+  int variable = activity_heap[0];
+  activity_heap[0] = activity_heap.back();
+  heap_position[activity_heap[0]] = 0;
+  activity_heap.pop_back();
+  heap_position[variable] = -1;
+  if (!activity_heap.empty()) {
+    heap_percolate_down(0);
+  }
+  return variable;
+}
+
+/*
+ * function to move a heap entry towards the root while it is more active than
+ * its parent
+ * Arguments : position - the index of the entry in the heap
+ */
+void SATSolverCDCL::heap_percolate_up(int position) {
+  int variable = activity_heap[position];
+  while (position > 0) {
+    int parent = (position - 1) / 2;
+    if (variable_activity[activity_heap[parent]] >=
+        variable_activity[variable]) {
+      break;
+    }
+    activity_heap[position] = activity_heap[parent];
+    heap_position[activity_heap[position]] = position;
+    position = parent;
+  }
+  activity_heap[position] = variable;
+  heap_position[variable] = position;
+}
+
+/*
+ * function to move a heap entry towards the leaves while a child is more
+ * active than it
+ * Arguments : position - the index of the entry in the heap
+ */
+void SATSolverCDCL::heap_percolate_down(int position) {
+  int variable = activity_heap[position];
+  while (2 * position + 1 < activity_heap.size()) {
+    int child = 2 * position + 1;
+    // pick the more active child
+    if (child + 1 < activity_heap.size() &&
+        variable_activity[activity_heap[child + 1]] >
+            variable_activity[activity_heap[child]]) {
+      child++;
+    }
+    if (variable_activity[activity_heap[child]] <=
+        variable_activity[variable]) {
+      break;
+    }
+    activity_heap[position] = activity_heap[child];
+    heap_position[activity_heap[position]] = position;
+    position = child;
+  }
+  activity_heap[position] = variable;
+  heap_position[variable] = position;
+}
+
+/*
+ * function to check if all variables have been assigned so far
+ * Return value : true, if yes, false, if no
+ */
+bool SATSolverCDCL::all_variables_assigned() {
+  return literal_count - eliminated_variable_count == trail.size();
+}
+
+/*
+ * function to display the result of the solver
+ * Arguments : result_status - the status that CDCL returned
+ */
+void SATSolverCDCL::show_result(int result_status) {
+  if (result_status == RetVal::r_satisfied) // if the formula is satisfiable
+  {
+    cout << "SAT" << endl;
+    write_model([](const char *characters, int count) {
+      fwrite(characters, 1, count, stdout);
+    });
+    fflush(stdout);
+  } else if (result_status == RetVal::r_unknown) // if the search stopped
+  {
+    cout << "UNKNOWN";
+  } else // if the formula is unsatisfiable
+  {
+    cout << "UNSAT";
+  }
+}
+
+/*
+ * function to write the values of all the variables, as the literals that are
+ * true separated by spaces and followed by 0. the literals are formatted into
+ * a buffer, which is handed out whenever it is nearly full, so that the model
+ * of a large formula is neither built as one string nor written through a
+ * stream number by number. variables which can take either value are
+ * arbitrarily true
+ * Arguments : output - the function to which the buffer is handed, with the
+ * number of characters in it
+ */
+void SATSolverCDCL::write_model(
+    const function<void(const char *, int)> &output) {
+  const int buffer_size = 1 << 16; // characters in the buffer
+  const int literal_size = 13;     // characters of a literal and its space
+  vector<char> buffer(buffer_size);
+  char *position = buffer.data();
+  char *limit = buffer.data() + buffer_size - literal_size;
+  for (int i = 0; i < literal_count; i++) {
+    if (i != 0) {
+      *position++ = ' ';
+    }
+    int literal = variable_to_literal(i, variable_value(i) == 0);
+    position = write_dimacs_literal(position, literal);
+    if (position >= limit) {
+      output(buffer.data(), position - buffer.data());
+      position = buffer.data();
+    }
+  }
+  *position++ = ' ';
+  *position++ = '0';
+  output(buffer.data(), position - buffer.data());
+}
+
+/*
+ * function to choose if statistics are reported. progress lines then go to
+ * standard error during the search, followed by the final statistics as JSON
+ * Arguments : enabled - true to report statistics, false not to, json_path -
+ * the file to write the final statistics to, or nullptr for standard error
+ * Return value : true, if the statistics can be reported, false, if the solver
+ * was built without them
+ */
+bool SATSolverCDCL::set_statistics(bool enabled, const char *json_path) {
+#ifdef SOLVER_STATISTICS
+  statistics_enabled = enabled;
+  statistics_path = (json_path == nullptr) ? "" : json_path;
+  if (progress_report == nullptr) {
+    progress_report = make_shared<ProgressReport>();
+  }
+  return true;
+#else
+  (void)json_path; // there is nowhere to write the statistics to
+  return !enabled;
+#endif
+}
+
+/*
+ * function to write a DRAT proof of unsatisfiability while solving, which
+ * ends with the empty clause when the formula is unsatisfiable
+ * Arguments : path - the path of the proof file, binary_format - true for the
+ * binary DRAT format, false for the text one, background - true to write the
+ * proof with a background thread
+ * Return value : true, if the proof file was opened, false, if not
+ */
+bool SATSolverCDCL::set_proof(const char *path, bool binary_format,
+                              bool background) {
+  proof = make_shared<ProofWriter>();
+  if (!proof->open(path, binary_format, background)) {
+    proof = nullptr;
+    return false;
+  }
+  return true;
+}
+
+/*
+ * function to write a line with the progress of the search on standard error,
+ * preceded by the column names if no line was written before. the line is
+ * made first and written whole, as the workers report at the same time
+ */
+void SATSolverCDCL::report_progress() {
+  long long learnt_count = max(statistics.learnt_clauses, 1LL);
+  ostringstream line;
+  line << "c " << setw(6) << worker_index << fixed << setprecision(1)
+       << setw(10)
+       << chrono::duration<double>(chrono::steady_clock::now() -
+                                   statistics.start_time)
+              .count()
+       << setw(11) << conflict_count << setw(11) << statistics.decisions
+       << setw(13) << propagation_count << setw(9) << restart_count
+       << setw(9) << statistics.learnt_clauses << setw(9)
+       << statistics.deleted_clauses << setw(9)
+       << (double)statistics.learnt_literals / learnt_count << setw(8)
+       << (double)statistics.learnt_lbd / learnt_count << setw(9)
+       << clause_arena.size() * sizeof(uint32_t) / (1024.0 * 1024.0) << '\n';
+  lock_guard<mutex> lock(progress_report->output_mutex);
+  if (!progress_report->header_written) {
+    cerr << "c worker   seconds  conflicts  decisions propagations restarts"
+            "   learnt  deleted avg_size avg_lbd arena_MB\n";
+    progress_report->header_written = true;
+  }
+  cerr << line.str() << flush;
+}
+
+/*
+ * function to write the final statistics as a JSON object, to the file chosen
+ * with set_statistics or to standard error
+ */
+void SATSolverCDCL::report_statistics() {
+  if (!statistics_enabled) {
+    return;
+  }
+  FILE *output = statistics_path.empty() ? stderr
+                                         : fopen(statistics_path.c_str(), "w");
+  if (output == nullptr) {
+    cerr << "Could not open " << statistics_path << endl;
+    return;
+  }
+  long long learnt_count = max(statistics.learnt_clauses, 1LL);
+  fprintf(output,
+          "{\"seed\": %u, \"variables\": %d, \"clauses\": %d, "
+          "\"decisions\": %lld, "
+          "\"propagations\": %lld, \"conflicts\": %lld, \"restarts\": %lld, "
+          "\"learnt_clauses\": %lld, \"deleted_clauses\": %lld, "
+          "\"average_learnt_size\": %.3f, \"average_learnt_lbd\": %.3f, "
+          "\"vivified_clauses\": %lld, \"vivified_literals\": %lld, "
+          "\"subsumed_clauses\": %lld, "
+          "\"arena_bytes\": %lld, \"learnt_bytes\": %lld, "
+          "\"variable_bytes\": %lld, "
+          "\"seconds\": {\"total\": %.6f, \"parse\": %.6f, "
+          "\"unit_propagate\": %.6f, \"conflict_analysis\": %.6f, "
+          "\"pick_branching_variable\": %.6f, \"inprocess\": %.6f}}\n",
+          random_seed, literal_count, (int)original_clauses.size(),
+          statistics.decisions,
+          propagation_count, conflict_count, restart_count,
+          statistics.learnt_clauses, statistics.deleted_clauses,
+          (double)statistics.learnt_literals / learnt_count,
+          (double)statistics.learnt_lbd / learnt_count,
+          statistics.vivified_clauses, statistics.vivified_literals,
+          statistics.subsumed_clauses,
+          (long long)(clause_arena.size() * sizeof(uint32_t)),
+          learnt_words * (long long)sizeof(uint32_t), variable_bytes(),
+          chrono::duration<double>(chrono::steady_clock::now() -
+                                   statistics.start_time)
+              .count(),
+          statistics.parse_seconds, statistics.propagate_seconds,
+          statistics.analyze_seconds, statistics.decide_seconds,
+          statistics.inprocess_seconds);
+  if (output != stderr) {
+    fclose(output);
+  }
+}
+
+/*
+ * function to add the counters and timers of a worker to those of this
+ * solver, so that the statistics cover all the workers
+ * Arguments : worker - the worker
+ */
+void SATSolverCDCL::merge_statistics(const SATSolverCDCL &worker) {
+  conflict_count += worker.conflict_count;
+  restart_count += worker.restart_count;
+  learnt_words += worker.learnt_words;
+  statistics.decisions += worker.statistics.decisions;
+  propagation_count += worker.propagation_count;
+  statistics.learnt_clauses += worker.statistics.learnt_clauses;
+  statistics.deleted_clauses += worker.statistics.deleted_clauses;
+  statistics.learnt_literals += worker.statistics.learnt_literals;
+  statistics.learnt_lbd += worker.statistics.learnt_lbd;
+  statistics.vivified_clauses += worker.statistics.vivified_clauses;
+  statistics.vivified_literals += worker.statistics.vivified_literals;
+  statistics.subsumed_clauses += worker.statistics.subsumed_clauses;
+  statistics.propagate_seconds += worker.statistics.propagate_seconds;
+  statistics.analyze_seconds += worker.statistics.analyze_seconds;
+  statistics.decide_seconds += worker.statistics.decide_seconds;
+  statistics.inprocess_seconds += worker.statistics.inprocess_seconds;
+}
+
+/*
+ * function to check if the search must stop, because another worker of the
+ * portfolio has finished, the solver was interrupted or one of the budgets is
+ * used up
+ * Return value : true, if yes, false, if no
+ */
+bool SATSolverCDCL::search_stopped() {
+  const int budget_check_interval = 256; // checks between looking at the
+                                         // clock and the memory
+  if ((stop_flag != nullptr && stop_flag->load(memory_order_relaxed)) ||
+      interrupt_flag->load(memory_order_relaxed)) {
+    return true;
+  }
+  if ((conflict_budget > 0 &&
+       conflict_count - budget_conflict_start >= conflict_budget) ||
+      (propagation_budget > 0 &&
+       propagation_count - budget_propagation_start >= propagation_budget)) {
+    return true;
+  }
+  if (budget_check_countdown-- > 0) {
+    return false;
+  }
+  budget_check_countdown = budget_check_interval;
+  if (time_budget > 0 &&
+      chrono::duration<double>(chrono::steady_clock::now() - budget_start_time)
+              .count() >= time_budget) {
+    return true;
+  }
+  return memory_budget > 0 && memory_bytes() >= memory_budget;
+}
+
+/*
+ * function to add the clauses learnt and shared by the other workers, at the
+ * top level. literals false at the top level are left out, satisfied clauses
+ * are skipped and unit clauses are assigned, and the result is propagated.
+ * the clauses are checked to be well formed, and the rest of them is dropped
+ * at the first one that is not, which the exchange should never hand out
+ * Return value : RetVal::r_unsatisfied if the shared clauses make the formula
+ * unsatisfiable, RetVal::r_normal otherwise
+ */
+int SATSolverCDCL::import_shared_clauses() {
+  shared_clauses.clear();
+  clause_exchange->import_clauses(worker_index, shared_clauses);
+  for (int start = 0; start < shared_clauses.size();) {
+    int size = shared_clauses[start];
+    bool well_formed = size >= 1 && size <= max_shared_clause_size &&
+                       start + size < shared_clauses.size();
+    for (int i = start + 1; i <= start + size && well_formed; i++) {
+      well_formed = shared_clauses[i] >= 0 &&
+                    shared_clauses[i] < 2 * literal_count;
+    }
+    if (!well_formed) {
+      break;
+    }
+    learnt_clause.clear();
+    bool satisfied = false;
+    for (int i = start + 1; i <= start + size && !satisfied; i++) {
+      int value = literal_value(shared_clauses[i]);
+      satisfied = value == 1;
+      if (value == -1) {
+        learnt_clause.push_back(shared_clauses[i]);
+      }
+    }
+    start += size + 1;
+    if (satisfied) {
+      continue;
+    } else if (learnt_clause.empty()) {
+      return RetVal::r_unsatisfied;
+    } else if (learnt_clause.size() == 1) {
+      assign_literal(learnt_clause[0], 0, -1);
+      continue;
+    }
+    int clause_reference = allocate_clause(learnt_clause, true);
+    learnt_clauses.push_back(clause_reference);
+    clause_header(clause_reference).lbd = min<int>(learnt_clause.size(), 3);
+    clause_count++;
+    watch_clause(clause_reference);
+  }
+  return unit_propagate(0);
+}
+
+/*
+ * function to give a portfolio worker its own seed, restart policy and
+ * heuristic parameters, so that the workers search differently. worker 0 keeps
+ * the configuration it was given
+ * Arguments : index - the index of the worker
+ */
+void SATSolverCDCL::diversify(int index) {
+  worker_index = index;
+  generator.seed(random_seed + index);
+  if (index == 0) {
+    return;
+  }
+  restart_policy =
+      (index % 2 == 1) ? RestartPolicy::rp_luby : RestartPolicy::rp_glucose;
+  const double decays[] = {0.95, 0.9, 0.85, 0.99};
+  activity_decay = decays[index % 4];
+  random_decision_frequency = 0.01 * (index % 5);
+  // start some workers from the opposite of the majority polarities
+  if (index % 3 == 2) {
+    for (int i = 0; i < literal_count; i++) {
+      literal_polarity[i] = -literal_polarity[i];
+    }
+  }
+}
+
+/*
+ * function to solve the problem with a portfolio of differently configured
+ * copies of the solver, each in its own thread, and display the result of the
+ * first one to finish. the formula is preprocessed once beforehand if asked
+ * Arguments : thread_count - the number of workers
+ */
+void SATSolverCDCL::solve_portfolio(int thread_count) {
+  start_budgets();
+  if (preprocessing_enabled) {
+    preprocess();
+  }
+  atomic<bool> stop(false);
+  atomic<int> winner(-1); // index of the first worker to finish
+  ClauseExchange exchange(thread_count, 1 << 16);
+  vector<SATSolverCDCL> workers(thread_count, *this);
+  vector<int> results(thread_count, RetVal::r_unknown);
+  vector<thread> threads;
+  for (int i = 0; i < thread_count; i++) {
+    workers[i].diversify(i);
+    workers[i].stop_flag = &stop;
+    workers[i].statistics = SolverStatistics();
+    workers[i].statistics.start_time = statistics.start_time;
+    workers[i].clause_exchange = &exchange;
+    threads.push_back(thread([&, i]() {
+      results[i] = workers[i].CDCL();
+      int no_winner = -1;
+      if (results[i] != RetVal::r_unknown &&
+          winner.compare_exchange_strong(no_winner, i)) {
+        stop.store(true); // tell the other workers to stop
+      }
+    }));
+  }
+  for (int i = 0; i < thread_count; i++) {
+    threads[i].join();
+  }
+  for (int i = 0; i < thread_count; i++) {
+    merge_statistics(workers[i]);
+  }
+  if (winner.load() == -1) { // every worker was stopped by the budgets
+    report_statistics();
+    show_result(RetVal::r_unknown);
+    return;
+  }
+  SATSolverCDCL &finished = workers[winner.load()];
+  cerr << "c worker " << winner.load() << " finished first" << endl;
+  if (results[winner.load()] == RetVal::r_satisfied) {
+    results[winner.load()] = finished.finish_model();
+  }
+  report_statistics();
+  finished.show_result(results[winner.load()]);
+}
+
+/*
+ * function to split the formula into cubes, which are sets of literals whose
+ * disjunction covers every assignment that may satisfy the formula. starting
+ * from the empty cube, cubes are split breadth first on the variable chosen by
+ * lookahead, until there are enough of them. cubes that lookahead refutes are
+ * left out, and cubes that assign every variable are not split further
+ * Arguments : cube_count - the number of cubes wanted, cubes - to store the
+ * cubes, in the one indexed signed form to be solved as assumptions
+ * Return value : the number of cubes refuted by lookahead
+ */
+int SATSolverCDCL::make_cubes(int cube_count, vector<vector<int>> &cubes) {
+  cubes.clear();
+  if (already_unsatisfied || assign_unit_clauses() == RetVal::r_unsatisfied ||
+      unit_propagate(0) == RetVal::r_unsatisfied) {
+    return 1; // the formula itself is refuted
+  }
+  int refuted_count = 0;
+  vector<vector<int>> open_cubes(1); // cubes yet to be split
+  int open_start = 0;                // index of the next cube to split
+  while (open_start < open_cubes.size() &&
+         cubes.size() + open_cubes.size() - open_start < cube_count) {
+    vector<int> cube = open_cubes[open_start++];
+    int branch_literal = lookahead_branch(cube);
+    if (branch_literal == -2) {
+      refuted_count++;
+    } else if (branch_literal == -1) {
+      cubes.push_back(cube);
+    } else {
+      cube.push_back(branch_literal);
+      open_cubes.push_back(cube);
+      cube.back() = negate_literal(branch_literal);
+      open_cubes.push_back(cube);
+    }
+  }
+  cubes.insert(cubes.end(), open_cubes.begin() + open_start,
+               open_cubes.end());
+  for (int i = 0; i < cubes.size(); i++) {
+    for (int j = 0; j < cubes[i].size(); j++) {
+      cubes[i][j] = unpack_literal(cubes[i][j]);
+    }
+  }
+  return refuted_count;
+}
+
+/*
+ * function to look ahead from a cube. the literals of the cube are assigned,
+ * and the most active unassigned variables are probed in both polarities. a
+ * polarity that gives a conflict is a failed literal, whose negation is added
+ * to the cube. the variable whose two polarities together imply the most
+ * literals is chosen to split on
+ * Arguments : cube - the cube, which is extended by the failed literals
+ * Return value : the positive literal of the variable to split on, -1 if every
+ * variable is assigned, or -2 if the cube was refuted
+ */
+int SATSolverCDCL::lookahead_branch(vector<int> &cube) {
+  const int candidate_count = 32; // number of variables probed
+  // assign the cube, one decision level per literal
+  bool refuted = false;
+  for (int i = 0; i < cube.size() && !refuted; i++) {
+    int value = literal_value(cube[i]);
+    if (value == 0) {
+      refuted = true;
+    } else if (value == -1) {
+      trail_level_start.push_back(trail.size());
+      assign_literal(cube[i], trail_level_start.size(), -1);
+      refuted = unit_propagate(trail_level_start.size()) ==
+                RetVal::r_unsatisfied;
+    }
+  }
+  if (refuted) {
+    backtrack(0);
+    return -2;
+  }
+  // the variables near the top of the heap are the most active ones
+  vector<int> candidates;
+  for (int i = 0;
+       i < activity_heap.size() && candidates.size() < candidate_count; i++) {
+    int variable = activity_heap[i];
+    if (variable_value(variable) == -1 && !variable_eliminated[variable]) {
+      candidates.push_back(variable_to_literal(variable, false));
+    }
+  }
+  long long best_score = -1;
+  int branch_literal = -1;
+  for (int i = 0; i < candidates.size(); i++) {
+    int literal = candidates[i];
+    if (literal_value(literal) != -1) {
+      continue; // implied by a failed literal found meanwhile
+    }
+    int positive = lookahead_literal(literal);
+    int negative = lookahead_literal(negate_literal(literal));
+    if (positive == -1 || negative == -1) {
+      if (positive == -1 && negative == -1) {
+        backtrack(0);
+        return -2;
+      }
+      // a failed literal, so its negation holds in the cube
+      int implied = (positive == -1) ? negate_literal(literal) : literal;
+      cube.push_back(implied);
+      trail_level_start.push_back(trail.size());
+      assign_literal(implied, trail_level_start.size(), -1);
+      if (unit_propagate(trail_level_start.size()) ==
+          RetVal::r_unsatisfied) {
+        backtrack(0);
+        return -2;
+      }
+      continue;
+    }
+    long long score = (long long)(positive + 1) * (negative + 1);
+    if (score > best_score) {
+      best_score = score;
+      branch_literal = literal;
+    }
+  }
+  // every candidate may have been assigned by failed literals
+  if (branch_literal == -1 && !all_variables_assigned()) {
+    for (int i = 0; i < literal_count; i++) {
+      if (variable_value(i) == -1 && !variable_eliminated[i]) {
+        branch_literal = variable_to_literal(i, false);
+        break;
+      }
+    }
+  }
+  backtrack(0);
+  return branch_literal;
+}
+
+/*
+ * function to assign a literal on a new decision level, propagate it and undo
+ * the assignments again
+ * Arguments : literal - the packed literal
+ * Return value : the number of literals implied, or -1 if propagation gave a
+ * conflict
+ */
+int SATSolverCDCL::lookahead_literal(int literal) {
+  int decision_level = trail_level_start.size() + 1;
+  trail_level_start.push_back(trail.size());
+  assign_literal(literal, decision_level, -1);
+  int result = unit_propagate(decision_level);
+  int implied_count = trail.size() - trail_level_start.back() - 1;
+  backtrack(decision_level - 1);
+  return (result == RetVal::r_unsatisfied) ? -1 : implied_count;
+}
+
+/*
+ * function to solve the problem by cube and conquer. lookahead splits the
+ * formula into cubes, which a pool of worker threads then solves as
+ * assumptions, every worker on its own copy of the formula. the first cube
+ * found satisfiable gives the model, and the formula is unsatisfiable once
+ * every cube is refuted. the time taken by every cube is reported on standard
+ * error
+ * Arguments : cube_count - the number of cubes wanted, thread_count - the
+ * number of workers
+ */
+void SATSolverCDCL::solve_cubes(int cube_count, int thread_count) {
+  start_budgets();
+  if (preprocessing_enabled) {
+    preprocess();
+  }
+  chrono::steady_clock::time_point lookahead_start =
+      chrono::steady_clock::now();
+  vector<vector<int>> cubes;
+  int refuted_count = make_cubes(cube_count, cubes);
+  cerr << "c lookahead made " << cubes.size() << " cubes and refuted "
+       << refuted_count << " in " << fixed << setprecision(3)
+       << chrono::duration<double>(chrono::steady_clock::now() -
+                                   lookahead_start)
+              .count()
+       << " s" << endl;
+
+  atomic<bool> stop(false);
+  atomic<int> satisfied_worker(-1); // worker that found a model, if any
+  atomic<bool> formula_refuted(false); // if a cube refuted every cube
+  CubePool pool(thread_count, cubes.size());
+  vector<SATSolverCDCL> workers(thread_count, *this);
+  vector<int> cube_results(cubes.size(), RetVal::r_unknown);
+  vector<double> cube_seconds(cubes.size(), -1); // -1 if never started
+  vector<thread> threads;
+  for (int i = 0; i < thread_count; i++) {
+    workers[i].stop_flag = &stop;
+    workers[i].worker_index = i;
+    workers[i].statistics = SolverStatistics();
+    workers[i].statistics.start_time = statistics.start_time;
+    threads.push_back(thread([&, i]() {
+      int cube;
+      while (!stop.load() && pool.take(i, cube)) {
+        chrono::steady_clock::time_point cube_start =
+            chrono::steady_clock::now();
+        cube_results[cube] = workers[i].solve_with_assumptions(cubes[cube]);
+        cube_seconds[cube] = chrono::duration<double>(
+                                 chrono::steady_clock::now() - cube_start)
+                                 .count();
+        int no_worker = -1;
+        if (cube_results[cube] == RetVal::r_satisfied &&
+            satisfied_worker.compare_exchange_strong(no_worker, i)) {
+          stop.store(true);
+        } else if (cube_results[cube] == RetVal::r_unsatisfied &&
+                   workers[i].failed_assumptions.empty()) {
+          formula_refuted.store(true);
+          stop.store(true); // unsatisfiable whatever the cube
+        } else if (cube_results[cube] == RetVal::r_unknown) {
+          stop.store(true); // a budget is used up, or the solver interrupted
+        }
+      }
+    }));
+  }
+  for (int i = 0; i < thread_count; i++) {
+    threads[i].join();
+  }
+
+  const char *result_names[] = {"SAT", "UNSAT", "stopped"};
+  double total_seconds = 0, longest_seconds = 0;
+  int solved_count = 0;
+  cerr << fixed << setprecision(3);
+  for (int i = 0; i < cubes.size(); i++) {
+    if (cube_seconds[i] < 0) {
+      continue;
+    }
+    cerr << "c cube " << i << " of " << cubes[i].size() << " literals: "
+         << result_names[cube_results[i]] << " in " << cube_seconds[i] << " s"
+         << endl;
+    total_seconds += cube_seconds[i];
+    longest_seconds = max(longest_seconds, cube_seconds[i]);
+    solved_count++;
+  }
+  cerr << "c solved " << solved_count << " cubes, " << total_seconds
+       << " s in total, " << total_seconds / max(solved_count, 1)
+       << " s on average, " << longest_seconds << " s at most" << endl;
+
+  for (int i = 0; i < thread_count; i++) {
+    merge_statistics(workers[i]);
+  }
+  report_statistics();
+  if (satisfied_worker.load() == -1) {
+    // the formula is only unsatisfiable if no cube was left unsolved
+    bool refuted = formula_refuted.load();
+    bool all_cubes_refuted = true;
+    for (int i = 0; i < cubes.size(); i++) {
+      all_cubes_refuted =
+          all_cubes_refuted && cube_results[i] == RetVal::r_unsatisfied;
+    }
+    show_result((refuted || all_cubes_refuted) ? RetVal::r_unsatisfied
+                                               : RetVal::r_unknown);
+    return;
+  }
+  // take the model of the worker, and extend it to the eliminated variables
+  vector<int8_t> &cube_model = workers[satisfied_worker.load()].model;
+  for (int i = 0; i < literal_count; i++) {
+    literal_values[variable_to_literal(i, false)] = cube_model[i];
+    literal_values[variable_to_literal(i, true)] =
+        (cube_model[i] == -1) ? -1 : 1 - cube_model[i];
+  }
+  show_result(finish_model());
+}
+
+/*
+ * function to solve the problem by calling the CDCL() function and then showing
+ * the result
+ */
+void SATSolverCDCL::solve() {
+  int result_status = solve_formula();
+  report_statistics();
+  show_result(result_status);
+}
+
+/*
+ * function to solve the formula that was read, preprocessing it first if
+ * asked, and to complete the model or the proof
+ * Return value : the result of CDCL()
+ */
+int SATSolverCDCL::solve_formula() {
+  start_budgets();
+  if (preprocessing_enabled) {
+    preprocess();
+  }
+  int result_status = CDCL();
+  if (result_status == RetVal::r_satisfied) {
+    result_status = finish_model();
+  }
+  if (proof != nullptr) {
+    if (result_status == RetVal::r_unsatisfied) {
+      proof->add_clause(nullptr, 0, -1); // the empty clause
+    }
+    proof->close();
+  }
+  return result_status;
+}
+
+/*
+ * function to solve many formulas, each in its own file, with a pool of
+ * copies of the solver. every copy solves one file after the other, and
+ * keeps the memory of its vectors from one to the next. one line is written
+ * for every file, with its path, its result, the seconds taken and, if it is
+ * satisfiable, the assignment ending with 0. the lines follow the order of
+ * the files, or the order in which they are solved. the budgets apply to
+ * every file, and no more files are started once the solver is interrupted
+ * Arguments : paths - the paths of the files, thread_count - the number of
+ * workers, completion_order - true to write the lines as the files are
+ * solved, false to write them in the order of the files
+ */
+void SATSolverCDCL::solve_batch(const vector<string> &paths, int thread_count,
+                                bool completion_order) {
+  atomic<int> next_path(0); // index of the next file to be solved
+  mutex output_mutex;       // held while writing the lines
+  vector<string> lines(paths.size()); // lines solved ahead of their turn
+  vector<char> line_ready(paths.size(), 0);
+  int next_line = 0; // index of the next line to write in the order of files
+  vector<SATSolverCDCL> workers(thread_count, *this);
+  vector<thread> threads;
+  for (int i = 0; i < thread_count; i++) {
+    workers[i].worker_index = i;
+    workers[i].quiet = true;
+    threads.push_back(thread([&, i]() {
+      string line;
+      int index;
+      while (!interrupt_flag->load(memory_order_relaxed) &&
+             (index = next_path.fetch_add(1)) < paths.size()) {
+        workers[i].solve_batch_file(paths[index], line);
+        lock_guard<mutex> lock(output_mutex);
+        if (completion_order) {
+          cout << line;
+        } else {
+          lines[index].swap(line);
+          line_ready[index] = 1;
+          while (next_line < paths.size() && line_ready[next_line]) {
+            cout << lines[next_line];
+            string().swap(lines[next_line]);
+            next_line++;
+          }
+        }
+        cout.flush();
+      }
+    }));
+  }
+  for (int i = 0; i < thread_count; i++) {
+    threads[i].join();
+  }
+}
+
+/*
+ * function to read and solve a file of a batch, and to make its line of
+ * output
+ * Arguments : path - the path of the file, line - to store the line, which
+ * ends with a newline
+ */
+void SATSolverCDCL::solve_batch_file(const string &path, string &line) {
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  line = path;
+  if (!initialize(path.c_str())) {
+    line += " ERROR\n";
+    return;
+  }
+  int result_status = solve_formula();
+  const char *result_names[] = {" SAT ", " UNSAT ", " UNKNOWN "};
+  line += result_names[result_status];
+  char seconds[32];
+  snprintf(seconds, sizeof(seconds), "%.3f",
+           chrono::duration<double>(chrono::steady_clock::now() - start)
+               .count());
+  line += seconds;
+  if (result_status == RetVal::r_satisfied) {
+    line += ' ';
+    write_model([&line](const char *characters, int count) {
+      line.append(characters, count);
+    });
+  }
+  line += '\n';
+}
+
+/*
+ * function to get a percentile of a list of values, by the nearest rank
+ * Arguments : values - the values, sorted in ascending order, which are not
+ * empty, percent - the percentile, from 0 to 100
+ * Return value : the smallest value that at least percent percent of the
+ * values do not exceed
+ */
+template <class T> T nearest_rank(const vector<T> &values, int percent) {
+  int rank = (percent * (long long)values.size() + 99) / 100;
+  return values[max(rank, 1) - 1];
+}
+
+/*
+ * function to solve the formula that was read with a number of seeds, on a
+ * pool of threads, to see how much its runtime depends on the random choices.
+ * every run solves a fresh copy of the formula, preprocessing it if asked,
+ * with the seeds that follow the seed of this solver, and the budgets apply to
+ * every run. one line is written per seed, in the order of the seeds, with
+ * its result, seconds and conflicts, followed by the median, the 90th
+ * percentile and the maximum of the seconds and of the conflicts. once the
+ * solver is interrupted, no more runs are started, and only the runs made are
+ * reported. a seed can then be repeated alone with set_seed()
+ * Arguments : seed_count - the number of seeds, thread_count - the number of
+ * runs at a time
+ */
+void SATSolverCDCL::profile_seeds(int seed_count, int thread_count) {
+  atomic<int> next_seed(0); // index of the next seed to run
+  vector<int> results(seed_count, RetVal::r_unknown);
+  vector<double> run_seconds(seed_count, 0);
+  vector<long long> run_conflicts(seed_count, 0);
+  vector<thread> threads;
+  for (int i = 0; i < min(thread_count, seed_count); i++) {
+    threads.push_back(thread([&]() {
+      int index;
+      while (!interrupt_flag->load(memory_order_relaxed) &&
+             (index = next_seed.fetch_add(1)) < seed_count) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        SATSolverCDCL run(*this);
+        run.quiet = true;
+        run.set_seed(random_seed + index);
+        results[index] = run.solve_formula();
+        run_seconds[index] =
+            chrono::duration<double>(chrono::steady_clock::now() - start)
+                .count();
+        run_conflicts[index] = run.conflict_count;
+      }
+    }));
+  }
+  for (int i = 0; i < threads.size(); i++) {
+    threads[i].join();
+  }
+  // every seed handed out was run, and the seeds are handed out in order
+  int run_count = min(next_seed.load(), seed_count);
+  run_seconds.resize(run_count);
+  run_conflicts.resize(run_count);
+  const char *result_names[] = {"SAT", "UNSAT", "UNKNOWN"};
+  printf("%-10s %-8s %10s %12s\n", "seed", "result", "seconds", "conflicts");
+  for (int i = 0; i < run_count; i++) {
+    printf("%-10u %-8s %10.3f %12lld\n", random_seed + i,
+           result_names[results[i]], run_seconds[i], run_conflicts[i]);
+  }
+  if (run_count == 0) {
+    return;
+  }
+  sort(run_seconds.begin(), run_seconds.end());
+  sort(run_conflicts.begin(), run_conflicts.end());
+  printf("%-10s %-8s %10s %12s\n", "", "median", "p90", "max");
+  printf("%-10s %-8.3f %10.3f %12.3f\n", "seconds",
+         nearest_rank(run_seconds, 50), nearest_rank(run_seconds, 90),
+         run_seconds.back());
+  printf("%-10s %-8lld %10lld %12lld\n", "conflicts",
+         nearest_rank(run_conflicts, 50), nearest_rank(run_conflicts, 90),
+         run_conflicts.back());
+  fflush(stdout);
+}
+
+/*
+ * function to add a clause to the formula, which may be done between calls to
+ * solve. literals false at the top level are left out, a clause satisfied at
+ * the top level is not added and a unit clause is assigned at the top level.
+ * variables beyond the current count are added
+ * Arguments : clause - the clause as non zero literals in the one indexed
+ * signed form
+ * Return value : RetVal::r_unknown if a literal is 0 or its variable is too
+ * large to be indexed, in which case nothing is added, RetVal::r_unsatisfied
+ * if the formula is now known to be unsatisfiable, RetVal::r_normal otherwise
+ */
+int SATSolverCDCL::add_clause(const vector<int> &clause) {
+  int variable_count = 0; // the largest variable in the clause
+  for (int i = 0; i < clause.size(); i++) {
+    if (!literal_in_range(clause[i])) {
+      return RetVal::r_unknown;
+    }
+    variable_count = max(variable_count, abs(clause[i]));
+  }
+  backtrack(0);
+  add_variables(variable_count);
+  learnt_clause.clear();
+  for (int i = 0; i < clause.size(); i++) {
+    learnt_clause.push_back(pack_literal(clause[i]));
+  }
+  sort(learnt_clause.begin(), learnt_clause.end());
+  learnt_clause.erase(unique(learnt_clause.begin(), learnt_clause.end()),
+                      learnt_clause.end());
+  int kept = 0; // number of literals kept in the clause
+  for (int i = 0; i < learnt_clause.size(); i++) {
+    int value = literal_value(learnt_clause[i]);
+    if (value == 1) {
+      return already_unsatisfied ? RetVal::r_unsatisfied : RetVal::r_normal;
+    } else if (value == -1) {
+      learnt_clause[kept++] = learnt_clause[i];
+    }
+  }
+  learnt_clause.resize(kept);
+  if (learnt_clause.empty()) {
+    already_unsatisfied = true;
+  } else if (learnt_clause.size() == 1) {
+    assign_literal(learnt_clause[0], 0, -1);
+  } else {
+    int clause_reference = allocate_clause(learnt_clause, false);
+    original_clauses.push_back(clause_reference);
+    watch_clause(clause_reference);
+  }
+  clause_count++;
+  // count the occurrences as the parser does, keeping the heap ordered
+  for (int i = 0; i < learnt_clause.size(); i++) {
+    int variable = literal_to_variable_index(learnt_clause[i]);
+    variable_activity[variable]++;
+    literal_polarity[variable] += literal_is_negative(learnt_clause[i]) ? -1 : 1;
+    if (heap_position[variable] != -1) {
+      heap_percolate_up(heap_position[variable]);
+    }
+  }
+  return already_unsatisfied ? RetVal::r_unsatisfied : RetVal::r_normal;
+}
+
+/*
+ * function to solve the formula under assumptions, which hold only for this
+ * call. the learnt clauses, activities and saved phases are kept for the
+ * next calls, and the formula is not preprocessed. the budgets count from the
+ * start of the call, and a call stopped by them or by interrupt() leaves the
+ * solver ready for the next one
+ * Arguments : assumed_literals - the literals assumed true
+ * Return value : RetVal::r_satisfied if the formula is satisfiable under the
+ * assumptions, RetVal::r_unsatisfied if it is not, RetVal::r_unknown if the
+ * search stopped first, or if an assumption is 0 or its variable is too large
+ * to be indexed, in which case nothing is solved
+ */
+int SATSolverCDCL::solve(const vector<int> &assumed_literals) {
+  start_budgets();
+  return solve_with_assumptions(assumed_literals);
+}
+
+/*
+ * function to solve the formula under assumptions, as solve does, but within
+ * the budgets started before, so that a cube worker has them for all its cubes
+ * Arguments : assumed_literals - the literals assumed true
+ * Return value : RetVal::r_satisfied if the formula is satisfiable under the
+ * assumptions, RetVal::r_unsatisfied if it is not, RetVal::r_unknown if the
+ * search stopped first, or if an assumption is 0 or its variable is too large
+ * to be indexed, in which case nothing is solved
+ */
+int SATSolverCDCL::solve_with_assumptions(const vector<int> &assumed_literals) {
+  int variable_count = 0; // the largest variable assumed
+  for (int i = 0; i < assumed_literals.size(); i++) {
+    if (!literal_in_range(assumed_literals[i])) {
+      failed_assumptions.clear();
+      model.clear();
+      return RetVal::r_unknown;
+    }
+    variable_count = max(variable_count, abs(assumed_literals[i]));
+  }
+  backtrack(0);
+  add_variables(variable_count);
+  assumptions.clear();
+  for (int i = 0; i < assumed_literals.size(); i++) {
+    assumptions.push_back(pack_literal(assumed_literals[i]));
+  }
+  failed_assumptions.clear();
+  model.clear();
+  // an assumption that already holds takes up a decision level of its own
+  if (level_stamp.size() < literal_count + assumptions.size() + 1) {
+    level_stamp.resize(literal_count + assumptions.size() + 1, 0);
+  }
+  int result_status = CDCL();
+  if (result_status == RetVal::r_satisfied) {
+    model.resize(literal_count);
+    for (int i = 0; i < literal_count; i++) {
+      model[i] = variable_value(i);
+    }
+  } else if (result_status == RetVal::r_unsatisfied &&
+             failed_assumptions.empty()) {
+    already_unsatisfied = true; // unsatisfiable without any assumption
+  }
+  // the failed assumptions are given back in the form they were passed in
+  for (int i = 0; i < failed_assumptions.size(); i++) {
+    failed_assumptions[i] = unpack_literal(failed_assumptions[i]);
+  }
+  backtrack(0);
+  assumptions.clear();
+  return result_status;
+}
+
+/*
+ * function to find the assumptions responsible for an assumption being false,
+ * by following the antecedents of the literals that falsify it back to the
+ * decisions, which are all assumptions
+ * Arguments : assumption - the assumption that is false
+ */
+void SATSolverCDCL::analyze_final(int assumption) {
+  failed_assumptions.clear();
+  failed_assumptions.push_back(assumption);
+  if (trail_level_start.empty()) {
+    return; // false at the top level, so it fails on its own
+  }
+  variable_seen[literal_to_variable_index(assumption)] = 1;
+  for (int i = trail.size() - 1; i >= trail_level_start[0]; i--) {
+    int variable = literal_to_variable_index(trail[i]);
+    if (!variable_seen[variable]) {
+      continue;
+    }
+    variable_seen[variable] = 0;
+    int antecedent = literal_antecedent[variable];
+    if (antecedent == -1) {
+      failed_assumptions.push_back(trail[i]);
+      continue;
+    }
+    int size;
+    const int *clause = antecedent_reason(variable, size);
+    for (int j = 0; j < size; j++) {
+      int other = literal_to_variable_index(clause[j]);
+      if (literal_decision_level[other] > 0) {
+        variable_seen[other] = 1;
+      }
+    }
+  }
+  variable_seen[literal_to_variable_index(assumption)] = 0;
+}
+
+/*
+ * function to get the value of a literal in the satisfying assignment found by
+ * the last call to solve
+ * Arguments : literal - the one indexed signed form of the literal
+ * Return value : 1 if the literal is true, 0 if it is false and -1 if there is
+ * no such assignment
+ */
+int SATSolverCDCL::get_model_value(int literal) {
+  int variable = abs(literal) - 1;
+  if (variable >= model.size() || model[variable] == -1) {
+    return -1;
+  }
+  return (model[variable] == 1) == (literal > 0) ? 1 : 0;
 }
 
 /*
- * the main() function
+ * function to get the assumptions that made the last call to solve
+ * unsatisfiable. the formula is unsatisfiable under any subset of the
+ * assumptions that contains these
+ * Return value : the failed assumptions, empty if the formula is
+ * unsatisfiable without assumptions
  */
-int main() {
-  SATSolverCDCL solver;
-  solver.initialize();
-  solver.solve();
-  return 0;
+const vector<int> &SATSolverCDCL::get_failed_assumptions() {
+  return failed_assumptions;
 }
@@ -0,0 +1,507 @@
+/*
+ * Interface of a SAT solver based on Conflict Driven Clause Learning with
+ * non-chronological backtracking, which can be linked into other programs
+ */
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "compact_vector.h"
+
+/*
+ * enum to store exit states for certain functions in the solver
+ */
+enum RetVal {
+  r_satisfied,   // the formula has been satisfied
+  r_unsatisfied, // the formula has been unsatisfied
+  r_unknown,     // the search stopped before the formula was resolved
+  r_normal       // the formula is unresolved so far
+};
+
+/*
+ * enum to store the policies for deciding when the search restarts
+ */
+enum RestartPolicy {
+  rp_none,   // the search never restarts
+  rp_luby,   // restart after a number of conflicts following the Luby series
+  rp_glucose // restart when recent learnt clauses have a high literal block
+             // distance compared to the long term average
+};
+
+class ClauseExchange;
+struct ClauseHeader;
+class ProgressReport;
+class ProofWriter;
+
+/*
+ * an entry of the implication list of a literal, for a binary clause that
+ * contains the literal. the other literal is stored inline, so that the clause
+ * does not have to be read to propagate it
+ */
+struct BinaryWatch {
+  int literal;          // the other literal of the clause
+  int clause_reference; // the reference to the clause in the arena
+};
+
+/*
+ * counters and timers of the search. they are only updated when the solver is
+ * built with SOLVER_STATISTICS defined, and the timers only run when the
+ * statistics are enabled
+ */
+struct SolverStatistics {
+  long long decisions = 0;       // number of decisions, including assumptions
+  long long learnt_clauses = 0;  // number of clauses learnt
+  long long deleted_clauses = 0; // number of learnt clauses deleted
+  long long learnt_literals = 0; // total size of the learnt clauses
+  long long learnt_lbd = 0;      // total lbd of the learnt clauses
+  long long vivified_clauses = 0;  // number of clauses shortened by vivifying
+  long long vivified_literals = 0; // number of literals they lost
+  long long subsumed_clauses = 0;  // number of clauses removed as subsumed
+  double parse_seconds = 0;      // time taken to read the formula
+  double propagate_seconds = 0;  // time spent in unit propagation
+  double analyze_seconds = 0;    // time spent in conflict analysis
+  double decide_seconds = 0;     // time spent picking branching variables
+  double inprocess_seconds = 0;  // time spent simplifying between restarts
+  // the time at which the solver started
+  std::chrono::steady_clock::time_point start_time =
+      std::chrono::steady_clock::now();
+};
+
+/*
+ * class containing the member variables and functions of the CDCL SAT solver
+ */
+class SATSolverCDCL {
+private:
+  /*
+   * inside the solver, literals are kept in a packed form. for the one indexed
+   * variable v, v is packed as 2 * (v - 1) and -v as 2 * (v - 1) + 1, so that
+   * a literal directly indexes the vectors kept per literal. the one indexed
+   * signed form is only used by the public functions
+   */
+
+  /*
+   * a vector to store the value of each packed literal, so that it is read
+   * without looking at the sign, where the value is
+   * 1 - true
+   * 0 - false
+   * -1 - unassigned
+   */
+  std::vector<int8_t> literal_values;
+
+  /*
+   * arena of 32 bit words that stores all the clauses contiguously, each as a
+   * ClauseHeader followed by its packed literals. a clause is referred to by
+   * the offset of its header, and NIL is represented by -1
+   */
+  std::vector<uint32_t> clause_arena;
+  std::vector<int> original_clauses; // references to the clauses of the formula
+  std::vector<int> learnt_clauses;   // references to the learnt clauses
+  int wasted_words; // number of arena words taken by deleted clauses
+
+  /*
+   * the learnt clause database is reduced every reduce_interval conflicts,
+   * with the interval growing by reduce_interval_increment each time, or
+   * earlier when the learnt clauses take up more than learnt_memory_budget
+   * bytes of the arena. learnt clauses with a literal block distance of at
+   * most glue_lbd are never removed
+   */
+  long long learnt_words; // number of arena words taken by learnt clauses
+  long long learnt_memory_budget; // limit on the bytes of learnt clauses, or
+                                  // 0 for no limit
+  long long conflict_count;       // number of conflicts so far
+  long long propagation_count;    // number of literals propagated so far
+  long long next_reduce_conflict; // conflict count of the next reduction
+  long long reduce_interval;      // conflicts between reductions
+  long long last_reduce_conflict; // conflict count of the last reduction
+  double clause_activity_increment; // amount by which clauses are bumped
+  std::vector<int> level_stamp; // for every decision level, the last stamp with
+                           // which it was counted in a literal block distance
+  int lbd_stamp;           // stamp of the current literal block distance
+
+  /*
+   * buffers reused by every conflict analysis, so that it does not allocate.
+   * variable_seen marks the variables that have been visited, which are
+   * recorded in seen_to_clear so that the marks can be undone
+   */
+  std::vector<char> variable_seen;
+  std::vector<int> learnt_clause;  // the clause being learnt
+  std::vector<int> minimize_stack; // literals left to visit while minimizing
+  std::vector<int> seen_to_clear;  // literals whose variables have been marked
+
+  /*
+   * vector that stores the last value assigned to each variable, which is
+   * reused when it is decided again, or -1 if it has never been assigned
+   */
+  std::vector<int8_t> saved_phase;
+
+  /*
+   * the search restarts according to restart_policy. the Luby policy allows
+   * luby_unit times the next term of the Luby series as the conflicts between
+   * restarts. the glucose policy keeps a fast and a slow exponential moving
+   * average of the literal block distances of the learnt clauses, and
+   * restarts when the fast one exceeds the slow one by a margin
+   */
+  int restart_policy;
+  long long restart_count;          // number of restarts so far
+  long long restart_conflict_count; // conflict count at the last restart
+  double lbd_fast_average;          // average over the recent conflicts
+  double lbd_slow_average;          // average over all conflicts
+
+  /*
+   * state of the simplification of the clauses at restarts, which is done
+   * once the conflict count reaches next_inprocess_conflict. the literals
+   * assigned at the top level are removed from the clauses when the trail has
+   * grown past simplified_trail_size. clauses are vivified with a tenth of the
+   * literals propagated by the search since the last time, during which
+   * ignored_clause, the clause being vivified, is not propagated. the clauses
+   * that were not yet checked are then used to remove the clauses they
+   * subsume
+   */
+  long long next_inprocess_conflict; // conflict count of the next pass
+  long long inprocess_interval;      // conflicts between passes
+  long long last_inprocess_propagations; // propagation count after the last
+                                         // pass
+  int simplified_trail_size; // top level trail size of the last removal
+  int ignored_clause;        // clause left out of propagation, or -1
+  std::vector<int> vivified_literals; // buffer of the clause being vivified
+
+  /*
+   * state of the preprocessing run before the search. occurrence_list stores,
+   * indexed like watch_list, the original clauses containing every literal.
+   * the clauses removed by eliminating a variable are kept in
+   * elimination_stack, each as its literals, starting with the literal of the
+   * eliminated variable, followed by its size, so that the model can be
+   * extended to the eliminated variables afterwards
+   */
+  bool preprocessing_enabled;
+  std::vector<std::vector<int>> occurrence_list;
+  std::vector<char> literal_mark; // marks on literals, indexed like watch_list
+  std::vector<char> variable_eliminated; // if a variable has been eliminated
+  int eliminated_variable_count;    // number of eliminated variables
+  std::vector<int> elimination_stack;
+  /*
+   * state of a portfolio worker. the search stops as soon as stop_flag is set,
+   * and short learnt clauses with a low literal block distance are exported
+   * to clause_exchange, from which the clauses of the other workers are
+   * imported at the top level. both are nullptr when solving alone
+   */
+  std::atomic<bool> *stop_flag;
+  ClauseExchange *clause_exchange;
+  int worker_index;                // index of this worker in the portfolio
+  std::vector<int> shared_clauses; // buffer of the imported clauses
+
+  /*
+   * limits on a call to solve, each 0 for no limit. the search stops with
+   * RetVal::r_unknown once a budget is used up, counting from the start of
+   * the call, or when interrupt_flag is set. the flag is shared with the
+   * copies made for the portfolio and cube workers, so that interrupting the
+   * solver stops all of them. the clock and the memory are only looked at
+   * every budget_check_interval checks, as they are slower to read
+   */
+  long long conflict_budget;    // conflicts allowed
+  long long propagation_budget; // literals propagated allowed
+  double time_budget;           // seconds allowed
+  long long memory_budget;      // bytes of clauses allowed
+  std::shared_ptr<std::atomic<bool>> interrupt_flag;
+  long long budget_conflict_start;    // conflict count at the start
+  long long budget_propagation_start; // propagation count at the start
+  std::chrono::steady_clock::time_point budget_start_time;
+  int budget_check_countdown; // checks left before the clock and the memory
+                              // are looked at
+
+  // top level units yet to be applied to the clauses while simplifying
+  std::vector<int> pending_units;
+  std::vector<int> subsumption_queue; // clauses yet to be used for subsumption
+  long long preprocessing_budget; // literal visits left for subsumption and
+                                  // elimination
+
+  /*
+   * vector that stores the activity of every variable, used for choosing the
+   * next variable to be assigned. it starts as the number of occurrences of
+   * the variable in the formula, and the variables involved in every conflict
+   * are bumped by activity_increment, which grows geometrically so that
+   * recent conflicts weigh more
+   */
+  std::vector<double> variable_activity;
+  double activity_increment; // amount by which activities are bumped
+  double activity_decay;     // factor by which old activities decay per
+                             // conflict
+  double random_decision_frequency; // fraction of decisions made on a random
+                                    // unassigned variable
+
+  /*
+   * binary max-heap of variables ordered by activity, containing at least all
+   * the unassigned variables. assigned variables are removed lazily when they
+   * reach the top
+   */
+  std::vector<int> activity_heap;
+  // index of each variable in the heap, -1 if absent
+  std::vector<int> heap_position;
+
+  /*
+   * vector that stores the difference in the number of positive and negative
+   * occurrences of the variable in the formula. this is updated when clauses
+   * are learnt
+   */
+  std::vector<int> literal_polarity;
+
+  int literal_count;    // number of variables in the formula
+  int clause_count;     // number of clauses in the formula
+  int kappa_antecedent; // antecedent of the conflict, kappa
+
+  /*
+   * vector to store the decision level of each variable
+   * when not yet assigned, it contains -1
+   */
+  std::vector<int> literal_decision_level;
+
+  /*
+   * vector to store the reference to the antecedent clause of each variable
+   * NIL is represented by -1. a variable implied through the implication lists
+   * stores the other literal of the binary clause instead, encoded below -1
+   * by binary_antecedent(), and binary_reason holds that literal when it is
+   * handed out as a reason
+   */
+  std::vector<int> literal_antecedent;
+  int binary_reason;
+
+  /*
+   * a 2D vector that stores, for every packed literal, the list of clauses in
+   * which it is currently watched. the first two literals of every clause with
+   * at least two literals are its watched literals
+   */
+  std::vector<CompactVector<int>> watch_list;
+
+  /*
+   * a 2D vector that stores, for every literal, the binary clauses containing
+   * it, indexed like the watch list. binary clauses are only kept here and not
+   * in the watch list
+   */
+  std::vector<CompactVector<BinaryWatch>> binary_watch;
+  long long watch_count;        // number of entries in the watch lists
+  long long binary_watch_count; // number of entries in the implication lists
+
+  /*
+   * vector that stores the assigned packed literals, in the order in which
+   * they were assigned
+   */
+  std::vector<int> trail;
+  int propagation_head; // index in the trail of the next literal whose
+                        // negation has to be propagated
+
+  /*
+   * vector that stores, for every decision level d > 0, the index in the trail
+   * at which the literals of level d start, at index d - 1
+   */
+  std::vector<int> trail_level_start;
+  bool already_unsatisfied;   // if the formula contains any empty clause
+                              // originally
+  /*
+   * generator of the random decisions, which is seeded with random_seed
+   * whenever a formula is read, so that solving a formula with a given seed
+   * on a single thread always takes the same search
+   */
+  unsigned int random_seed;
+  std::mt19937 generator;
+
+  /*
+   * state of incremental solving. the assumptions are decided in order at the
+   * first decision levels of the search, one level each. when they cannot all
+   * hold, failed_assumptions receives those responsible, and the values of
+   * the variables are copied to model when a satisfying assignment is found
+   */
+  std::vector<int> assumptions;
+  std::vector<int> failed_assumptions;
+  std::vector<int8_t> model;
+
+  /*
+   * statistics of the search. when statistics_enabled is set, progress is
+   * reported on standard error every progress_interval conflicts, and the
+   * final statistics are written as JSON to statistics_path, or to standard
+   * error if it is empty. the progress lines are written through
+   * progress_report, which is shared with the portfolio and cube workers, so
+   * that the column names are written once and the lines do not mix
+   */
+  SolverStatistics statistics;
+  bool statistics_enabled;
+  std::string statistics_path;
+  std::shared_ptr<ProgressReport> progress_report;
+  bool quiet; // if the messages on standard error are left out, as they are
+              // for every file of a batch
+
+  /*
+   * writer of the DRAT proof, or nullptr if no proof is written. every clause
+   * learnt or derived while simplifying is added to the proof, and every
+   * clause removed or replaced by a shorter one is deleted from it
+   */
+  std::shared_ptr<ProofWriter> proof;
+
+  void reset_formula();    // to start over with an empty formula
+  void add_variables(int); // to grow the formula to a number of variables
+  void analyze_final(int); // to find the assumptions that made one false
+  int unit_propagate(int); // to perform unit propagation
+  // to assign a literal with given value, antecedent and decision level
+  void assign_literal(int, int, int);
+  void unassign_literal(int); // to unassign a given literal
+  void backtrack(int); // to unassign all literals above a decision level
+  // to get the value of a packed literal, 1 if true, 0 if false and -1 if
+  // unassigned
+  int literal_value(int);
+  int variable_value(int); // to get the value of a variable in the same way
+  void watch_clause(int); // to start watching the first two literals of a
+                          // clause
+  // to store a clause in the arena and return its reference
+  int allocate_clause(const std::vector<int> &, bool);
+  ClauseHeader &clause_header(int); // to get the header of a clause
+  int *clause_literals(int);        // to get the literals of a clause
+  void delete_clause(int);          // to mark a clause as deleted
+  // to remove a binary clause from the implication list of a literal
+  void unwatch_binary_clause(int, int);
+  void collect_garbage(); // to compact the arena by removing deleted clauses
+  // to count the distinct decision levels among the literals of a clause
+  int literal_block_distance(const std::vector<int> &);
+  void bump_clause_activity(int); // to bump the activity of a learnt clause
+  bool clause_is_locked(int);     // to check if a clause is an antecedent
+  void reduce_learnt_clauses();   // to delete about half the learnt clauses
+  void bump_variable_activity(int); // to bump the activity of a variable
+  void heap_insert(int);            // to insert a variable into the heap
+  int heap_remove_max(); // to remove and return the most active variable
+  void heap_percolate_up(int);   // to move a heap entry up to its place
+  void heap_percolate_down(int); // to move a heap entry down to its place
+  int conflict_analysis_and_backtrack(
+      int); // to perform conflict analysis and backtrack
+  // to resolve the clause being learnt with another clause
+  int resolve(int, int, int);
+  // to get the literals of the antecedent of a variable other than its own
+  const int *antecedent_reason(int, int &);
+  // to check if a literal of the learnt clause is implied by the others
+  bool literal_is_redundant(int, unsigned int);
+  unsigned int decision_level_signature(int); // to get the bit of a level
+  void update_lbd_averages(int);              // to add a learnt clause's lbd
+  bool restart_is_due(); // to check if the restart policy asks for a restart
+  long long luby(long long); // to get a term of the Luby series
+  int assign_unit_clauses(); // to assign the original unit clauses
+  void preprocess();         // to simplify the formula before the search
+  bool probe_failed_literals(); // to assign the negation of failed literals
+  void add_occurrences(int);    // to add a clause to the occurrence lists
+  void remove_occurrence(int, int); // to remove a clause from an occurrence
+                                    // list
+  void remove_clause(int);         // to delete a clause and its occurrences
+  bool add_top_level_unit(int);    // to assign a unit found while simplifying
+  bool strengthen_clause(int, int); // to remove a literal from a clause
+  bool simplify_top_level_units(); // to simplify with the pending units
+  bool subsume_clauses();          // to run the subsumption queue
+  bool eliminate_variable(int);    // to eliminate a variable by resolution
+  void extend_model(); // to assign the eliminated variables in a model
+  int inprocess();     // to simplify the clauses at a restart
+  // to remove the literals assigned at the top level from the clauses
+  void remove_top_level_literals();
+  // to vivify the clauses of a list within a number of propagations
+  int vivify_clauses(std::vector<int> &, long long);
+  int vivify_clause(int); // to shorten a clause by propagating its negation
+  // to replace a clause by the shorter clause in learnt_clause
+  int replace_clause(int);
+  void subsume_with_new_clauses(); // to remove clauses subsumed by new ones
+  int finish_model();  // to extend a model and check it against the formula
+  // to check if the search must stop, because another worker has finished,
+  // the solver was interrupted or a budget is used up
+  bool search_stopped();
+  void start_budgets();   // to count the budgets from now on
+  long long memory_bytes(); // to estimate the bytes taken by the solver
+  long long variable_bytes(); // to count the bytes kept per variable
+  // to solve under assumptions within the budgets already started
+  int solve_with_assumptions(const std::vector<int> &);
+  // to add the clauses shared by the other workers at the top level
+  int import_shared_clauses();
+  void diversify(int); // to vary the heuristics of a portfolio worker
+  // to split the formula into cubes by lookahead
+  int make_cubes(int, std::vector<std::vector<int>> &);
+  // to extend a cube by failed literals and choose the variable to split on
+  int lookahead_branch(std::vector<int> &);
+  int lookahead_literal(int); // to count the literals implied by a literal
+  void report_progress();   // to write a progress line
+  void report_statistics(); // to write the final statistics as JSON
+  // to add the counters of a worker to those of this solver
+  void merge_statistics(const SATSolverCDCL &);
+  int pick_branching_variable(); // to pick the next free assignment
+  bool all_variables_assigned(); // to check if all variables have already been
+                                 // assigned
+  void show_result(int);         // to display the result of the solver
+  // to write the model through a buffer handed to a function
+  void write_model(const std::function<void(const char *, int)> &);
+  // to preprocess and solve the formula, and complete the model or the proof
+  int solve_formula();
+  // to solve a file of a batch and make its line of output
+  void solve_batch_file(const std::string &, std::string &);
+
+public:
+  SATSolverCDCL()
+      : learnt_memory_budget(0), restart_policy(RestartPolicy::rp_glucose),
+        preprocessing_enabled(false), stop_flag(nullptr),
+        clause_exchange(nullptr), worker_index(0), conflict_budget(0),
+        propagation_budget(0), time_budget(0), memory_budget(0),
+        interrupt_flag(std::make_shared<std::atomic<bool>>(false)),
+        activity_decay(0.95), random_decision_frequency(0.02),
+        random_seed(std::random_device()()), statistics_enabled(false),
+        quiet(false) {
+    reset_formula();
+  } // constructor
+  // to initialize the solver from a file, or standard input for nullptr
+  bool initialize(const char *);
+  // to limit the bytes taken by learnt clauses, 0 for no limit
+  void set_learnt_memory_budget(long long);
+  void set_restart_policy(int); // to choose when the search restarts
+  void set_preprocessing(bool); // to choose if the formula is simplified first
+  void set_seed(unsigned int);  // to choose the seed of the random decisions
+  unsigned int get_seed();      // to get the seed of the random decisions
+  // to choose the fraction of decisions made on a random variable
+  void set_random_decision_frequency(double);
+  // to choose the factor by which variable activities decay per conflict
+  void set_activity_decay(double);
+  // to limit the conflicts, propagated literals, seconds and bytes of clauses
+  // of every call to solve, 0 for no limit
+  void set_conflict_budget(long long);
+  void set_propagation_budget(long long);
+  void set_time_budget(double);
+  void set_memory_budget(long long);
+  // to stop the search as soon as possible, which is safe to call from a
+  // signal handler or another thread
+  void interrupt();
+  void clear_interrupt(); // to allow the search again after an interrupt
+  // to choose if statistics are reported, and where the final ones go
+  bool set_statistics(bool, const char *);
+  // to write a DRAT proof of unsatisfiability to a file
+  bool set_proof(const char *, bool, bool);
+  int CDCL(); // to perform the CDCL algorithm and return the appropriate result
+              // state
+  void solve(); // to solve the problem and display the result
+  // to solve the problem with a portfolio of threads and display the result
+  void solve_portfolio(int);
+  // to solve the problem by cube and conquer with a number of cubes and
+  // threads, and display the result
+  void solve_cubes(int, int);
+  // to solve many files with a pool of threads, writing a line for each
+  void solve_batch(const std::vector<std::string> &, int, bool);
+  // to solve the formula with a number of seeds on a number of threads, and
+  // report the distributions of the times and conflicts
+  void profile_seeds(int, int);
+  // to add a clause to the formula between calls to solve
+  int add_clause(const std::vector<int> &);
+  // to solve the formula under assumptions, keeping what was learnt
+  int solve(const std::vector<int> &);
+  // to get the value of a literal in the last satisfying assignment
+  int get_model_value(int);
+  // to get the assumptions that made the last call unsatisfiable
+  const std::vector<int> &get_failed_assumptions();
+};
+
+#endif